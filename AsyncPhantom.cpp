@@ -0,0 +1,119 @@
+#include "AsyncPhantom.h"
+
+AsyncPhantom::AsyncPhantom(const MemoryPhantom& phantom, size_t workerCount)
+    : phantom(phantom) {
+    workerCount = std::max<size_t>(1, workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.emplace_back([this] { Run(); });
+    }
+}
+
+AsyncPhantom::~AsyncPhantom() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+std::future<std::vector<uint8_t>> AsyncPhantom::ReadBytes(uintptr_t addr, size_t size) {
+    auto promise = std::make_shared<std::promise<std::vector<uint8_t>>>();
+    std::future<std::vector<uint8_t>> future = promise->get_future();
+    Enqueue(false, addr, nullptr, size, [promise](bool success, std::span<const uint8_t> data) {
+        promise->set_value(success ? std::vector<uint8_t>(data.begin(), data.end()) : std::vector<uint8_t>());
+    });
+    return future;
+}
+
+std::future<bool> AsyncPhantom::WriteBytes(uintptr_t addr, const std::vector<uint8_t>& data) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> future = promise->get_future();
+    Enqueue(true, addr, data.data(), data.size(), [promise](bool success, std::span<const uint8_t>) { promise->set_value(success); });
+    return future;
+}
+
+size_t AsyncPhantom::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inFlight;
+}
+
+void AsyncPhantom::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return inFlight == 0; });
+}
+
+void AsyncPhantom::Enqueue(bool write, uintptr_t addr, const void* src, size_t size, Completion complete) {
+    Request request{ write, addr, std::vector<uint8_t>(size), std::move(complete) };
+    if (src) memcpy(request.data.data(), src, size);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(request));
+        inFlight++;
+    }
+    wake.notify_one();
+}
+
+// Everything queued since the last pass is drained at once, so a burst of requests becomes a handful of batches
+void AsyncPhantom::Run() {
+    std::vector<Request> requests;
+    ReadBatch reads;
+    WriteBatch writes;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+
+            size_t count = std::min(queue.size(), MaxBatch);
+            for (size_t i = 0; i < count; i++) {
+                requests.push_back(std::move(queue.front()));
+                queue.pop_front();
+            }
+        }
+
+        Process(requests, reads, writes);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight -= requests.size();
+            if (inFlight == 0) idle.notify_all();
+        }
+        requests.clear();
+    }
+}
+
+// Consecutive requests of the same kind share one batch; a switch between reads and writes starts a new one
+void AsyncPhantom::Process(std::vector<Request>& requests, ReadBatch& reads, WriteBatch& writes) {
+    size_t first = 0;
+    while (first < requests.size()) {
+        bool write = requests[first].write;
+        size_t last = first;
+        while (last < requests.size() && requests[last].write == write) last++;
+
+        if (write) {
+            writes.Clear();
+            for (size_t i = first; i < last; i++) {
+                writes.AddBytes(requests[i].addr, requests[i].data.data(), requests[i].data.size());
+            }
+            phantom.Execute(writes);
+            for (size_t i = first; i < last; i++) {
+                requests[i].complete(writes.Succeeded(i - first), {});
+            }
+        }
+        else {
+            reads.Clear();
+            for (size_t i = first; i < last; i++) {
+                reads.AddBytes(requests[i].addr, requests[i].data.data(), requests[i].data.size());
+            }
+            phantom.Execute(reads);
+            for (size_t i = first; i < last; i++) {
+                requests[i].complete(reads.Succeeded(i - first), requests[i].data);
+            }
+        }
+
+        first = last;
+    }
+}
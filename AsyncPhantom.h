@@ -0,0 +1,106 @@
+#ifndef ASYNCPHANTOM_H
+#define ASYNCPHANTOM_H
+
+#include "MemoryPhantom.h"
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+class AsyncPhantom {
+public:
+    static constexpr size_t MaxBatch = 4096;
+
+    // With one worker, requests complete in submission order; more workers trade ordering for throughput.
+    // Workers call the phantom's const members concurrently, which is safe. Its non-const members (Attach,
+    // Detach, EnableReadCache, ...) must not run while requests are pending; call WaitIdle first.
+    explicit AsyncPhantom(const MemoryPhantom& phantom, size_t workerCount = 1);
+    ~AsyncPhantom();
+
+    AsyncPhantom(const AsyncPhantom&) = delete;
+    AsyncPhantom& operator=(const AsyncPhantom&) = delete;
+
+    template<typename T>
+    std::future<std::optional<T>> Read(uintptr_t addr) {
+        auto promise = std::make_shared<std::promise<std::optional<T>>>();
+        std::future<std::optional<T>> future = promise->get_future();
+        Read<T>(addr, [promise](std::optional<T> value) { promise->set_value(value); });
+        return future;
+    }
+
+    template<typename T>
+    std::future<std::optional<T>> Read(uintptr_t addr, int offset) {
+        return Read<T>(addr + offset);
+    }
+
+    // The callback runs on an I/O worker
+    template<typename T>
+    void Read(uintptr_t addr, std::function<void(std::optional<T>)> callback) {
+        static_assert(std::is_trivially_copyable_v<T>, "Async reads require a trivially copyable type");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout must be read with MemoryPhantom::Read<T>");
+
+        Enqueue(false, addr, nullptr, sizeof(T), [callback = std::move(callback)](bool success, std::span<const uint8_t> data) {
+            if (!success) {
+                callback(std::nullopt);
+                return;
+            }
+            T value;
+            memcpy(&value, data.data(), sizeof(T));
+            callback(value);
+        });
+    }
+
+    std::future<std::vector<uint8_t>> ReadBytes(uintptr_t addr, size_t size);
+
+    template<typename T>
+    std::future<bool> Write(uintptr_t addr, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Async writes require a trivially copyable type");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout cannot be written as a block");
+
+        auto promise = std::make_shared<std::promise<bool>>();
+        std::future<bool> future = promise->get_future();
+        Enqueue(true, addr, &value, sizeof(T), [promise](bool success, std::span<const uint8_t>) { promise->set_value(success); });
+        return future;
+    }
+
+    template<typename T>
+    std::future<bool> Write(uintptr_t addr, int offset, const T& value) {
+        return Write<T>(addr + offset, value);
+    }
+
+    std::future<bool> WriteBytes(uintptr_t addr, const std::vector<uint8_t>& data);
+
+    size_t Pending() const;
+    void WaitIdle();
+
+    const MemoryPhantom& Phantom() const { return phantom; }
+
+private:
+    using Completion = std::function<void(bool success, std::span<const uint8_t> data)>;
+
+    struct Request {
+        bool write;
+        uintptr_t addr;
+        std::vector<uint8_t> data;
+        Completion complete;
+    };
+
+    void Enqueue(bool write, uintptr_t addr, const void* src, size_t size, Completion complete);
+    void Run();
+    void Process(std::vector<Request>& requests, ReadBatch& reads, WriteBatch& writes);
+
+    const MemoryPhantom& phantom;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<Request> queue;
+    size_t inFlight = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,224 @@
+// Self-contained benchmark for the read/write paths and scanners.
+// Re-launches itself as a child process holding a known memory layout and measures against that child.
+//   Benchmark.exe [filter]   runs every benchmark whose name contains filter
+
+#include "MemoryPhantom.h"
+#include "PointerChain.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    constexpr size_t TargetSize = 16 * 1024 * 1024;
+    constexpr size_t ChainDepth = 4;
+    constexpr size_t ChainCount = 64;
+    constexpr const char* Signature = "48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? 8B 40 10";
+    constexpr uint8_t SignatureBytes[] = { 0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0, 0x74, 0x05, 0x8B, 0x40, 0x10 };
+
+    // Sent from the child to the parent over its stdout pipe
+    struct TargetLayout {
+        uintptr_t buffer;
+        size_t size;
+        uintptr_t string;
+        uintptr_t chains;
+    };
+
+    int RunChild() {
+        uint8_t* buffer = static_cast<uint8_t*>(VirtualAlloc(nullptr, TargetSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (!buffer) return 1;
+
+        for (size_t i = 0; i < TargetSize; i++) buffer[i] = static_cast<uint8_t>(i * 31 + (i >> 12));
+        memcpy(buffer + TargetSize - 4096, SignatureBytes, sizeof(SignatureBytes));
+        memset(buffer + TargetSize - 4096 + sizeof(SignatureBytes), 0xCC, 64);
+
+        const char name[] = "weapon_ak47_default_skin_name";
+        char* string = reinterpret_cast<char*>(buffer + 4096);
+        memcpy(string, name, sizeof(name));
+
+        // Chain c: slot c holds node 0, node n at +0x10 points at node n + 1, spread one page apart
+        uintptr_t* chains = reinterpret_cast<uintptr_t*>(buffer + 8192);
+        uint8_t* nodes = buffer + 64 * 1024;
+        for (size_t c = 0; c < ChainCount; c++) {
+            uint8_t* node = nodes + c * ChainDepth * 4096;
+            chains[c] = reinterpret_cast<uintptr_t>(node);
+            for (size_t n = 0; n + 1 < ChainDepth; n++) {
+                *reinterpret_cast<uintptr_t*>(node + n * 4096 + 0x10) = reinterpret_cast<uintptr_t>(node + (n + 1) * 4096);
+            }
+        }
+
+        TargetLayout layout{ reinterpret_cast<uintptr_t>(buffer), TargetSize, reinterpret_cast<uintptr_t>(string), reinterpret_cast<uintptr_t>(chains) };
+        DWORD written = 0;
+        WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), &layout, sizeof(layout), &written, nullptr);
+        FlushFileBuffers(GetStdHandle(STD_OUTPUT_HANDLE));
+
+        Sleep(INFINITE);
+        return 0;
+    }
+
+    struct Child {
+        PROCESS_INFORMATION process{};
+        TargetLayout layout{};
+
+        ~Child() {
+            if (!process.hProcess) return;
+            TerminateProcess(process.hProcess, 0);
+            WaitForSingleObject(process.hProcess, INFINITE);
+            CloseHandle(process.hThread);
+            CloseHandle(process.hProcess);
+        }
+    };
+
+    bool SpawnChild(Child& child) {
+        SECURITY_ATTRIBUTES attributes{ sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+        HANDLE readPipe = nullptr, writePipe = nullptr;
+        if (!CreatePipe(&readPipe, &writePipe, &attributes, 0)) return false;
+        SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+
+        wchar_t path[MAX_PATH];
+        GetModuleFileNameW(nullptr, path, MAX_PATH);
+        std::wstring commandLine = L"\"" + std::wstring(path) + L"\" --child";
+
+        STARTUPINFOW startup{};
+        startup.cb = sizeof(startup);
+        startup.dwFlags = STARTF_USESTDHANDLES;
+        startup.hStdOutput = writePipe;
+        startup.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        startup.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+        bool started = CreateProcessW(nullptr, commandLine.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startup, &child.process);
+        CloseHandle(writePipe);
+        if (!started) {
+            CloseHandle(readPipe);
+            return false;
+        }
+
+        DWORD received = 0;
+        bool ok = ReadFile(readPipe, &child.layout, sizeof(child.layout), &received, nullptr) && received == sizeof(child.layout);
+        CloseHandle(readPipe);
+        return ok;
+    }
+
+    class Bench {
+    public:
+        static constexpr double MinSeconds = 0.25;
+
+        Bench(const MemoryPhantom& phantom, const char* filter) : phantom(phantom), filter(filter) {
+            printf("%-36s %12s %12s %12s %12s\n", "benchmark", "iterations", "ns/op", "MB/s", "syscalls/op");
+        }
+
+        // Doubles the iteration count until a run lasts MinSeconds, then reports that run
+        template<typename F>
+        void Run(const char* name, size_t bytesPerOp, F&& body) {
+            if (filter && !strstr(name, filter)) return;
+
+            for (uint64_t iterations = 1;; iterations *= 2) {
+                uint64_t syscalls = Syscalls();
+                auto start = std::chrono::steady_clock::now();
+                for (uint64_t i = 0; i < iterations; i++) body();
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                syscalls = Syscalls() - syscalls;
+
+                if (seconds < MinSeconds && iterations < (1ull << 40)) continue;
+
+                double nsPerOp = seconds * 1e9 / iterations;
+                double throughput = bytesPerOp ? bytesPerOp * iterations / seconds / (1024.0 * 1024.0) : 0.0;
+                printf("%-36s %12llu %12.1f %12.1f %12.3f\n", name, static_cast<unsigned long long>(iterations), nsPerOp,
+                    throughput, static_cast<double>(syscalls) / iterations);
+                return;
+            }
+        }
+
+    private:
+        // ReadProcessMemory and WriteProcessMemory calls made by this thread so far
+        uint64_t Syscalls() const {
+            for (const auto& stats : phantom.GetThreadStats()) {
+                if (stats.thread == std::this_thread::get_id()) return stats.reads + stats.writes;
+            }
+            return 0;
+        }
+
+        const MemoryPhantom& phantom;
+        const char* filter;
+    };
+
+    template<typename T>
+    void Sink(const T& value) {
+        static volatile T sink;
+        sink = value;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--child") == 0) return RunChild();
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    Child child;
+    if (!SpawnChild(child)) {
+        fprintf(stderr, "failed to start the benchmark target\n");
+        return 1;
+    }
+
+    MemoryPhantom phantom;
+    if (!phantom.Attach(child.process.dwProcessId)) {
+        fprintf(stderr, "failed to attach to the benchmark target\n");
+        return 1;
+    }
+
+    const TargetLayout& target = child.layout;
+    const uintptr_t data = target.buffer + 2 * 1024 * 1024;
+    Bench bench(phantom, filter);
+
+    bench.Run("ReadInt", sizeof(int), [&] { Sink(phantom.ReadInt(data)); });
+    bench.Run("Read<Vector3>", sizeof(Vector3), [&] { Sink(phantom.Read<Vector3>(data).x); });
+
+    for (size_t size : { size_t(8), size_t(64), size_t(4096), size_t(65536), size_t(1024 * 1024) }) {
+        std::vector<uint8_t> out(size);
+        std::string name = "ReadBytes/" + std::to_string(size);
+        bench.Run(name.c_str(), size, [&] { Sink(phantom.ReadBytes(data, std::span<uint8_t>(out))); });
+    }
+
+    bench.Run("ReadString/32", 32, [&] { Sink(phantom.ReadString(target.string, 32).size()); });
+    std::string text;
+    bench.Run("ReadStringInto/256", 0, [&] { Sink(phantom.ReadStringInto(target.string, text, 256)); });
+
+    std::vector<PointerChain> chains;
+    for (size_t c = 0; c < ChainCount; c++) {
+        std::vector<ptrdiff_t> offsets(ChainDepth, 0x10);
+        offsets.front() = static_cast<ptrdiff_t>(c * sizeof(uintptr_t));
+        chains.emplace_back(target.chains, std::move(offsets));
+    }
+    bench.Run("PointerChain/Resolve", 0, [&] {
+        chains[0].Invalidate();
+        Sink(chains[0].Resolve(phantom).value_or(0));
+    });
+    bench.Run("PointerChain/ResolveAll/64", 0, [&] {
+        for (PointerChain& chain : chains) chain.Invalidate();
+        Sink(PointerChain::ResolveAll(phantom, chains));
+    });
+
+    std::vector<int> values(256);
+    ReadBatch dense, sparse;
+    for (size_t i = 0; i < values.size(); i++) {
+        dense.Add(data + i * 64, values[i]);
+        sparse.Add(data + i * 8192, values[i]);
+    }
+    bench.Run("ReadBatch/256/dense", values.size() * sizeof(int), [&] { Sink(phantom.Execute(dense)); });
+    bench.Run("ReadBatch/256/sparse", values.size() * sizeof(int), [&] { Sink(phantom.Execute(sparse)); });
+
+    phantom.EnableReadCache();
+    bench.Run("ReadInt/cached/16-per-frame", 16 * sizeof(int), [&] {
+        phantom.BeginFrame();
+        for (int field = 0; field < 16; field++) Sink(phantom.ReadInt(data, field * 4));
+    });
+    phantom.DisableReadCache();
+
+    const uintptr_t scratch = target.buffer + 4 * 1024 * 1024;
+    bench.Run("WriteInt", sizeof(int), [&] { Sink(phantom.WriteInt(scratch, 1337)); });
+    WriteBatch writes;
+    for (int i = 0; i < 64; i++) writes.Add(scratch + i * 16, i);
+    bench.Run("WriteBatch/64", 64 * sizeof(int), [&] { Sink(phantom.Execute(writes)); });
+
+    auto pattern = BytePattern::Parse(Signature);
+    bench.Run("PatternScan/16MiB", target.size, [&] { Sink(phantom.PatternScan(target.buffer, target.size, *pattern).value_or(0)); });
+
+    return 0;
+}
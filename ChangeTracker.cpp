@@ -0,0 +1,204 @@
+#include "ChangeTracker.h"
+#include <bit>
+
+namespace {
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+    inline uint64_t Load64(const uint8_t* p) {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t Load32(const uint8_t* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t Round(uint64_t acc, uint64_t lane) {
+        acc += lane * Prime2;
+        return std::rotl(acc, 31) * Prime1;
+    }
+
+    inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+        acc ^= Round(0, value);
+        return acc * Prime1 + Prime4;
+    }
+}
+
+uint64_t ChangeTracker::Hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + Prime1 + Prime2;
+        uint64_t v2 = seed + Prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - Prime1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = Round(v1, Load64(p));
+            v2 = Round(v2, Load64(p + 8));
+            v3 = Round(v3, Load64(p + 16));
+            v4 = Round(v4, Load64(p + 24));
+        }
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else {
+        hash = seed + Prime5;
+    }
+
+    hash += size;
+    for (; p + 8 <= end; p += 8) {
+        hash ^= Round(0, Load64(p));
+        hash = std::rotl(hash, 27) * Prime1 + Prime4;
+    }
+    if (p + 4 <= end) {
+        hash ^= static_cast<uint64_t>(Load32(p)) * Prime1;
+        hash = std::rotl(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        hash ^= *p * Prime5;
+        hash = std::rotl(hash, 11) * Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+size_t ChangeTracker::PageCount(const Range& range) const {
+    constexpr size_t page = MemoryPhantom::PageSize;
+    return (range.addr + range.size - 1) / page - range.addr / page + 1;
+}
+
+size_t ChangeTracker::Track(uintptr_t addr, size_t size) {
+    if (addr == 0 || size == 0) return 0;
+
+    Range range{};
+    range.id = nextId++;
+    range.addr = addr;
+    range.size = size;
+    range.data.assign(size, 0);
+    range.hashes.assign(PageCount(range), 0);
+    range.valid.assign(range.hashes.size(), 0);
+    ranges.push_back(std::move(range));
+    return ranges.back().id;
+}
+
+bool ChangeTracker::Untrack(size_t id) {
+    auto it = std::find_if(ranges.begin(), ranges.end(), [id](const Range& range) { return range.id == id; });
+    if (it == ranges.end()) return false;
+    ranges.erase(it);
+    return true;
+}
+
+void ChangeTracker::Clear() {
+    ranges.clear();
+    dirty.clear();
+}
+
+const ChangeTracker::Range* ChangeTracker::FindRange(size_t id) const {
+    auto it = std::find_if(ranges.begin(), ranges.end(), [id](const Range& range) { return range.id == id; });
+    return it != ranges.end() ? &*it : nullptr;
+}
+
+// One request per page of every range; the batch merges neighbouring pages into single reads
+// and falls back to the individual pages when a merged read fails
+size_t ChangeTracker::Update() {
+    constexpr uintptr_t page = MemoryPhantom::PageSize;
+
+    size_t total = 0;
+    for (const Range& range : ranges) total += range.size;
+    incoming.resize(total);
+
+    batch.Clear();
+    size_t offset = 0;
+    for (const Range& range : ranges) {
+        uintptr_t end = range.addr + range.size;
+        for (uintptr_t start = range.addr; start < end;) {
+            uintptr_t chunkEnd = std::min(end, (start & ~(page - 1)) + page);
+            batch.AddBytes(start, incoming.data() + offset + (start - range.addr), chunkEnd - start);
+            start = chunkEnd;
+        }
+        offset += range.size;
+    }
+    if (batch.Size()) phantom.Execute(batch);
+
+    dirty.clear();
+    std::span<const ReadRequest> requests = batch.Requests();
+    size_t request = 0;
+    size_t changed = 0;
+    offset = 0;
+    for (Range& range : ranges) {
+        range.dirtyBegin = dirty.size();
+        for (size_t i = 0; i < range.hashes.size(); i++) {
+            const ReadRequest& chunk = requests[request++];
+            if (!chunk.success) continue;
+
+            size_t at = chunk.addr - range.addr;
+            const uint8_t* bytes = incoming.data() + offset + at;
+            uint64_t hash = Hash(bytes, chunk.size);
+            if (range.valid[i] && range.hashes[i] == hash) continue;
+
+            range.hashes[i] = hash;
+            range.valid[i] = 1;
+            memcpy(range.data.data() + at, bytes, chunk.size);
+            changed++;
+
+            if (dirty.size() > range.dirtyBegin && dirty.back().End() == chunk.addr) dirty.back().size += chunk.size;
+            else dirty.push_back({ chunk.addr, chunk.size });
+        }
+        range.dirtyEnd = dirty.size();
+        offset += range.size;
+    }
+    return changed;
+}
+
+std::span<const DirtyRange> ChangeTracker::Dirty(size_t id) const {
+    const Range* range = FindRange(id);
+    if (!range || range->dirtyEnd > dirty.size()) return {};
+    return std::span<const DirtyRange>(dirty).subspan(range->dirtyBegin, range->dirtyEnd - range->dirtyBegin);
+}
+
+bool ChangeTracker::IsDirty(uintptr_t addr, size_t size) const {
+    for (const DirtyRange& range : dirty) {
+        if (addr < range.End() && range.addr < addr + size) return true;
+    }
+    return false;
+}
+
+std::span<const uint8_t> ChangeTracker::Data(size_t id) const {
+    const Range* range = FindRange(id);
+    return range ? std::span<const uint8_t>(range->data) : std::span<const uint8_t>();
+}
+
+std::span<const uint8_t> ChangeTracker::View(uintptr_t addr, size_t size) const {
+    constexpr size_t page = MemoryPhantom::PageSize;
+    if (size == 0) return {};
+
+    for (const Range& range : ranges) {
+        if (addr < range.addr || addr + size > range.addr + range.size) continue;
+
+        // Pages that were never read hold zeros, not target memory
+        size_t first = addr / page - range.addr / page;
+        size_t last = (addr + size - 1) / page - range.addr / page;
+        bool valid = true;
+        for (size_t i = first; i <= last && valid; i++) valid = range.valid[i] != 0;
+        if (valid) return std::span<const uint8_t>(range.data).subspan(addr - range.addr, size);
+    }
+    return {};
+}
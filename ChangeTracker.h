@@ -0,0 +1,80 @@
+#ifndef CHANGETRACKER_H
+#define CHANGETRACKER_H
+
+#include "MemoryPhantom.h"
+#include <cstring>
+
+struct DirtyRange {
+    uintptr_t addr;
+    size_t size;
+
+    uintptr_t End() const { return addr + size; }
+};
+
+// Keeps a copy of each tracked range and a hash per page of it. Update reads the ranges with one ReadBatch
+// and reports, as merged dirty ranges, only the pages whose hash changed, so a caller can skip parsing the rest.
+// Pages that fail to read keep their last contents and are not reported; every readable page is dirty once
+// after Track.
+class ChangeTracker {
+public:
+    explicit ChangeTracker(const MemoryPhantom& phantom) : phantom(phantom) {}
+
+    ChangeTracker(const ChangeTracker&) = delete;
+    ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+    // Returns an id for Untrack, Data and Dirty, or 0 for an empty range
+    size_t Track(uintptr_t addr, size_t size);
+    bool Untrack(size_t id);
+    void Clear();
+
+    // Returns the number of changed pages
+    size_t Update();
+
+    // Changed ranges of the last Update, sorted per tracked range and clipped to it
+    std::span<const DirtyRange> Dirty() const { return dirty; }
+    std::span<const DirtyRange> Dirty(size_t id) const;
+    bool IsDirty(uintptr_t addr, size_t size) const;
+
+    // Latest contents of a tracked range; empty for an unknown id
+    std::span<const uint8_t> Data(size_t id) const;
+    // Tracked bytes at addr, if one range covers all of them
+    std::span<const uint8_t> View(uintptr_t addr, size_t size) const;
+
+    template<typename T>
+    bool Get(uintptr_t addr, T& out) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ChangeTracker values must be trivially copyable");
+        std::span<const uint8_t> bytes = View(addr, sizeof(T));
+        if (bytes.empty()) return false;
+        memcpy(&out, bytes.data(), sizeof(T));
+        return true;
+    }
+
+    size_t Size() const { return ranges.size(); }
+
+    // XXH64
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed = 0);
+
+private:
+    struct Range {
+        size_t id;
+        uintptr_t addr;
+        size_t size;
+        std::vector<uint8_t> data;
+        std::vector<uint64_t> hashes;
+        std::vector<uint8_t> valid;
+        size_t dirtyBegin;
+        size_t dirtyEnd;
+    };
+
+    size_t PageCount(const Range& range) const;
+    const Range* FindRange(size_t id) const;
+
+    const MemoryPhantom& phantom;
+    std::vector<Range> ranges;
+    std::vector<DirtyRange> dirty;
+    ReadBatch batch;
+    std::vector<uint8_t> incoming;
+    size_t nextId = 1;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Monotonic memory_resource for buffers that live for one frame. Deallocation is a no-op and Reset makes
+// everything reusable at once. Reset keeps the memory: the blocks of a frame that overflowed are folded into
+// one block of their combined size, so a steady workload stops allocating from upstream after a few frames.
+// Not thread-safe; use one arena per thread.
+class FrameArena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t initialSize = 0, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream) {
+        if (initialSize) AddBlock(initialSize);
+    }
+
+    ~FrameArena() { Release(); }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Everything allocated since the last Reset becomes invalid
+    void Reset() {
+        if (blocks.size() > 1) {
+            size_t total = Capacity();
+            Release();
+            AddBlock(total);
+        }
+        current = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    // Returns every block to upstream
+    void Release() {
+        for (const Block& block : blocks) upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+        blocks.clear();
+        current = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    // Bytes handed out since the last Reset, without alignment padding
+    size_t Used() const { return used; }
+
+    size_t Capacity() const {
+        size_t total = 0;
+        for (const Block& block : blocks) total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::byte* data;
+        size_t size;
+    };
+
+    void AddBlock(size_t size) {
+        blocks.push_back({ static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size });
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (true) {
+            if (current < blocks.size()) {
+                const Block& block = blocks[current];
+                uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+                uintptr_t aligned = (base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+                size_t end = static_cast<size_t>(aligned - base) + bytes;
+                if (end <= block.size) {
+                    offset = end;
+                    used += bytes;
+                    return reinterpret_cast<void*>(aligned);
+                }
+                if (current + 1 < blocks.size()) {
+                    current++;
+                    offset = 0;
+                    continue;
+                }
+            }
+
+            size_t size = std::max({ bytes + alignment, DefaultBlockSize, blocks.empty() ? size_t(0) : blocks.back().size * 2 });
+            AddBlock(size);
+            current = blocks.size() - 1;
+            offset = 0;
+        }
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream;
+    std::vector<Block> blocks;
+    size_t current = 0;
+    size_t offset = 0;
+    size_t used = 0;
+};
+
+#endif
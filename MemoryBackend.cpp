@@ -0,0 +1,243 @@
+#include "MemoryBackend.h"
+#include <dbghelp.h>
+#include <algorithm>
+#include <cstring>
+
+std::shared_ptr<MappedSectionBackend> MappedSectionBackend::Open(const wchar_t* name, uintptr_t remoteBase, size_t size,
+    uint64_t offset, bool writable) {
+    if (!name) return nullptr;
+
+    HANDLE mapping = OpenFileMappingW(writable ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ, FALSE, name);
+    if (!mapping) return nullptr;
+
+    auto backend = FromHandle(mapping, remoteBase, size, offset, writable);
+    CloseHandle(mapping);
+    return backend;
+}
+
+std::shared_ptr<MappedSectionBackend> MappedSectionBackend::FromHandle(HANDLE mapping, uintptr_t remoteBase, size_t size,
+    uint64_t offset, bool writable) {
+    if (!mapping || remoteBase == 0 || size == 0) return nullptr;
+
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_READ | FILE_MAP_WRITE : FILE_MAP_READ,
+        static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset & 0xFFFFFFFF), size);
+    if (!view) return nullptr;
+
+    return std::shared_ptr<MappedSectionBackend>(new MappedSectionBackend(static_cast<uint8_t*>(view), remoteBase, size, writable));
+}
+
+MappedSectionBackend::~MappedSectionBackend() {
+    UnmapViewOfFile(view);
+}
+
+bool MappedSectionBackend::Read(uintptr_t addr, void* buffer, size_t length) const {
+    if (!Covers(addr, length)) return false;
+    memcpy(buffer, view + (addr - remoteBase), length);
+    return true;
+}
+
+bool MappedSectionBackend::Write(uintptr_t addr, const void* buffer, size_t length) const {
+    if (!writable || !Covers(addr, length)) return false;
+    memcpy(view + (addr - remoteBase), buffer, length);
+    return true;
+}
+
+std::span<const uint8_t> MappedSectionBackend::View(uintptr_t addr, size_t length) const {
+    if (!Covers(addr, length)) return {};
+    return std::span<const uint8_t>(view + (addr - remoteBase), length);
+}
+
+std::unique_ptr<MappedFile> MappedFile::Open(const wchar_t* path) {
+    if (!path) return nullptr;
+
+    HANDLE file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || static_cast<uint64_t>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>(new MappedFile(file, mapping, static_cast<const uint8_t*>(data), static_cast<size_t>(size.QuadPart)));
+}
+
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(file);
+}
+
+void FileBackend::Finish() {
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.base < b.base; });
+
+    if (regions.empty()) {
+        for (const Range& range : ranges) {
+            regions.push_back({ range.base, range.size, MEM_COMMIT, PAGE_READONLY, MEM_PRIVATE });
+        }
+    }
+    std::sort(regions.begin(), regions.end(), [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+}
+
+// Reads may span several ranges as long as they are back to back
+bool FileBackend::Read(uintptr_t addr, void* buffer, size_t length) const {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), addr, [](uintptr_t value, const Range& range) { return value < range.base; });
+    if (it == ranges.begin()) return false;
+    --it;
+
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    uintptr_t at = addr;
+    size_t remaining = length;
+    while (remaining > 0) {
+        if (it == ranges.end() || at < it->base || at - it->base >= it->size) return false;
+
+        size_t take = std::min(remaining, static_cast<size_t>(it->size - (at - it->base)));
+        memcpy(out, it->data + (at - it->base), take);
+        out += take;
+        at += take;
+        remaining -= take;
+        ++it;
+    }
+    return true;
+}
+
+std::span<const uint8_t> FileBackend::View(uintptr_t addr, size_t length) const {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), addr, [](uintptr_t value, const Range& range) { return value < range.base; });
+    if (it == ranges.begin()) return {};
+    --it;
+
+    if (addr - it->base >= it->size || length > it->size - (addr - it->base)) return {};
+    return std::span<const uint8_t>(it->data + (addr - it->base), length);
+}
+
+namespace {
+    template<typename T>
+    bool ReadStruct(const MappedFile& file, uint64_t offset, T& out) {
+        const uint8_t* at = file.At(offset, sizeof(T));
+        if (!at) return false;
+        memcpy(&out, at, sizeof(T));
+        return true;
+    }
+
+    std::string ReadMinidumpString(const MappedFile& file, RVA rva) {
+        ULONG32 length = 0;
+        if (!ReadStruct(file, rva, length)) return std::string();
+
+        const uint8_t* chars = file.At(static_cast<uint64_t>(rva) + sizeof(ULONG32), length);
+        if (!chars) return std::string();
+
+        std::wstring wide(length / sizeof(WCHAR), L'\0');
+        memcpy(wide.data(), chars, wide.size() * sizeof(WCHAR));
+
+        int size = WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), -1, nullptr, 0, NULL, NULL);
+        if (size <= 1) return std::string();
+        std::string result(size - 1, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), -1, result.data(), size, NULL, NULL);
+        return result;
+    }
+}
+
+std::shared_ptr<MinidumpBackend> MinidumpBackend::Open(const wchar_t* path) {
+    auto file = MappedFile::Open(path);
+    if (!file) return nullptr;
+
+    std::shared_ptr<MinidumpBackend> backend(new MinidumpBackend(std::move(file)));
+    if (!backend->Parse()) return nullptr;
+    return backend;
+}
+
+bool MinidumpBackend::Parse() {
+    MINIDUMP_HEADER header;
+    if (!ReadStruct(*file, 0, header) || header.Signature != MINIDUMP_SIGNATURE) return false;
+
+    for (ULONG32 i = 0; i < header.NumberOfStreams; i++) {
+        MINIDUMP_DIRECTORY directory;
+        if (!ReadStruct(*file, header.StreamDirectoryRva + static_cast<uint64_t>(i) * sizeof(MINIDUMP_DIRECTORY), directory)) return false;
+        uint64_t at = directory.Location.Rva;
+
+        if (directory.StreamType == Memory64ListStream) {
+            MINIDUMP_MEMORY64_LIST list;
+            if (!ReadStruct(*file, at, list)) continue;
+
+            uint64_t dataRva = list.BaseRva;
+            at += sizeof(ULONG64) * 2;
+            for (ULONG64 r = 0; r < list.NumberOfMemoryRanges; r++) {
+                MINIDUMP_MEMORY_DESCRIPTOR64 descriptor;
+                if (!ReadStruct(*file, at + r * sizeof(descriptor), descriptor)) break;
+
+                const uint8_t* data = file->At(dataRva, descriptor.DataSize);
+                if (!data) break;
+                ranges.push_back({ static_cast<uintptr_t>(descriptor.StartOfMemoryRange), static_cast<size_t>(descriptor.DataSize), data });
+                dataRva += descriptor.DataSize;
+            }
+        }
+        else if (directory.StreamType == MemoryListStream) {
+            ULONG32 count = 0;
+            if (!ReadStruct(*file, at, count)) continue;
+
+            at += sizeof(ULONG32);
+            for (ULONG32 r = 0; r < count; r++) {
+                MINIDUMP_MEMORY_DESCRIPTOR descriptor;
+                if (!ReadStruct(*file, at + static_cast<uint64_t>(r) * sizeof(descriptor), descriptor)) break;
+
+                const uint8_t* data = file->At(descriptor.Memory.Rva, descriptor.Memory.DataSize);
+                if (!data) continue;
+                ranges.push_back({ static_cast<uintptr_t>(descriptor.StartOfMemoryRange), descriptor.Memory.DataSize, data });
+            }
+        }
+        else if (directory.StreamType == MemoryInfoListStream) {
+            MINIDUMP_MEMORY_INFO_LIST list;
+            if (!ReadStruct(*file, at, list) || list.SizeOfEntry < sizeof(MINIDUMP_MEMORY_INFO)) continue;
+
+            at += list.SizeOfHeader;
+            for (ULONG64 r = 0; r < list.NumberOfEntries; r++) {
+                MINIDUMP_MEMORY_INFO info;
+                if (!ReadStruct(*file, at + r * list.SizeOfEntry, info)) break;
+                regions.push_back({ static_cast<uintptr_t>(info.BaseAddress), static_cast<size_t>(info.RegionSize), info.State, info.Protect, info.Type });
+            }
+        }
+        else if (directory.StreamType == ModuleListStream) {
+            ULONG32 count = 0;
+            if (!ReadStruct(*file, at, count)) continue;
+
+            at += sizeof(ULONG32);
+            for (ULONG32 m = 0; m < count; m++) {
+                MINIDUMP_MODULE module;
+                if (!ReadStruct(*file, at + static_cast<uint64_t>(m) * sizeof(module), module)) break;
+
+                std::string path = ReadMinidumpString(*file, module.ModuleNameRva);
+                size_t slash = path.find_last_of("\\/");
+                std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+                modules.push_back({ static_cast<uintptr_t>(module.BaseOfImage), module.SizeOfImage, std::move(name), std::move(path) });
+            }
+        }
+    }
+
+    Finish();
+    return !ranges.empty();
+}
+
+std::shared_ptr<RawSnapshotBackend> RawSnapshotBackend::Open(const wchar_t* path, uintptr_t remoteBase) {
+    if (remoteBase == 0) return nullptr;
+
+    auto file = MappedFile::Open(path);
+    if (!file) return nullptr;
+
+    std::shared_ptr<RawSnapshotBackend> backend(new RawSnapshotBackend(std::move(file)));
+    backend->ranges.push_back({ remoteBase, backend->file->Size(), backend->file->Data() });
+    backend->Finish();
+    return backend;
+}
@@ -0,0 +1,151 @@
+#ifndef MEMORYBACKEND_H
+#define MEMORYBACKEND_H
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "RegionMap.h"
+
+struct ProcessModule {
+    uintptr_t base;
+    size_t size;
+    std::string name;
+    std::string path;
+
+    uintptr_t End() const { return base + size; }
+};
+
+// Source of target memory consulted before ReadProcessMemory/WriteProcessMemory.
+// Implementations must be safe to call from several threads at once.
+class MemoryBackend {
+public:
+    virtual ~MemoryBackend() = default;
+
+    // Returning false hands the request on to the process handle, if the phantom has one
+    virtual bool Read(uintptr_t addr, void* buffer, size_t size) const = 0;
+    virtual bool Write(uintptr_t /*addr*/, const void* /*buffer*/, size_t /*size*/) const { return false; }
+
+    // Zero-copy access; empty when the range is not directly addressable
+    virtual std::span<const uint8_t> View(uintptr_t /*addr*/, size_t /*size*/) const { return {}; }
+
+    // Offline backends describe the captured address space; used when the phantom has no process handle
+    virtual std::vector<MemoryRegion> Regions() const { return {}; }
+    virtual std::vector<ProcessModule> Modules() const { return {}; }
+};
+
+// A section shared by a cooperative target, mapped into this process at the address the target sees it at
+class MappedSectionBackend : public MemoryBackend {
+public:
+    static std::shared_ptr<MappedSectionBackend> Open(const wchar_t* name, uintptr_t remoteBase, size_t size,
+        uint64_t offset = 0, bool writable = false);
+    // The view stays valid after the caller closes the mapping handle
+    static std::shared_ptr<MappedSectionBackend> FromHandle(HANDLE mapping, uintptr_t remoteBase, size_t size,
+        uint64_t offset = 0, bool writable = false);
+
+    ~MappedSectionBackend() override;
+
+    MappedSectionBackend(const MappedSectionBackend&) = delete;
+    MappedSectionBackend& operator=(const MappedSectionBackend&) = delete;
+
+    bool Read(uintptr_t addr, void* buffer, size_t size) const override;
+    bool Write(uintptr_t addr, const void* buffer, size_t size) const override;
+    std::span<const uint8_t> View(uintptr_t addr, size_t size) const override;
+
+    uintptr_t RemoteBase() const { return remoteBase; }
+    size_t Size() const { return size; }
+    bool IsWritable() const { return writable; }
+
+private:
+    MappedSectionBackend(uint8_t* view, uintptr_t remoteBase, size_t size, bool writable)
+        : view(view), remoteBase(remoteBase), size(size), writable(writable) {}
+
+    bool Covers(uintptr_t addr, size_t length) const {
+        return addr >= remoteBase && length <= size && addr - remoteBase <= size - length;
+    }
+
+    uint8_t* view;
+    uintptr_t remoteBase;
+    size_t size;
+    bool writable;
+};
+
+// Read-only view of a whole file
+class MappedFile {
+public:
+    static std::unique_ptr<MappedFile> Open(const wchar_t* path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+    // Bounds-checked pointer into the file; nullptr when [offset, offset + length) is out of range
+    const uint8_t* At(uint64_t offset, uint64_t length) const {
+        return offset <= size && length <= size - offset ? data + offset : nullptr;
+    }
+
+private:
+    MappedFile(HANDLE file, HANDLE mapping, const uint8_t* data, size_t size)
+        : file(file), mapping(mapping), data(data), size(size) {}
+
+    HANDLE file;
+    HANDLE mapping;
+    const uint8_t* data;
+    size_t size;
+};
+
+// Captured memory held in a mapped file as sorted, non-overlapping ranges
+class FileBackend : public MemoryBackend {
+public:
+    bool Read(uintptr_t addr, void* buffer, size_t size) const override;
+    std::span<const uint8_t> View(uintptr_t addr, size_t size) const override;
+    std::vector<MemoryRegion> Regions() const override { return regions; }
+    std::vector<ProcessModule> Modules() const override { return modules; }
+
+    size_t RangeCount() const { return ranges.size(); }
+
+protected:
+    struct Range {
+        uintptr_t base;
+        size_t size;
+        const uint8_t* data;
+    };
+
+    explicit FileBackend(std::unique_ptr<MappedFile> file) : file(std::move(file)) {}
+
+    // Sorts the ranges and derives committed read-only regions when the file carries none
+    void Finish();
+
+    std::unique_ptr<MappedFile> file;
+    std::vector<Range> ranges;
+    std::vector<MemoryRegion> regions;
+    std::vector<ProcessModule> modules;
+};
+
+// Full or partial Windows minidump (.dmp): Memory64List/MemoryList, MemoryInfoList and ModuleList streams
+class MinidumpBackend : public FileBackend {
+public:
+    static std::shared_ptr<MinidumpBackend> Open(const wchar_t* path);
+
+private:
+    using FileBackend::FileBackend;
+
+    bool Parse();
+};
+
+// Flat dump of one contiguous range captured at remoteBase
+class RawSnapshotBackend : public FileBackend {
+public:
+    static std::shared_ptr<RawSnapshotBackend> Open(const wchar_t* path, uintptr_t remoteBase);
+
+private:
+    using FileBackend::FileBackend;
+};
+
+#endif
@@ -1,10 +1,15 @@
 #include "MemoryPhantom.h"
 #include <psapi.h>
+#include <algorithm>
+#include <bit>
 
-MemoryPhantom::MemoryPhantom() : hProcess(nullptr), processId(0) {}
+MemoryPhantom::MemoryPhantom()
+    : hProcess(nullptr), processId(0), grantedAccess(0), cacheEnabled(false), cacheTtl(0), cacheEpoch(0), cacheGeneration(0),
+    threads(std::make_shared<ThreadRegistry>()), moduleAutoRefresh(true),
+    regionMapEnabled(false), regionTtl(RegionRefreshInterval), regionVersion(0) {}
 
-MemoryPhantom::MemoryPhantom(DWORD pid, DWORD accessRights) : hProcess(nullptr), processId(0) {
-    Attach(pid, accessRights);
+MemoryPhantom::MemoryPhantom(DWORD pid, AccessRequest access) : MemoryPhantom() {
+    Attach(pid, access);
 }
 
 MemoryPhantom::~MemoryPhantom() {
@@ -12,9 +17,18 @@ MemoryPhantom::~MemoryPhantom() {
 }
 
 MemoryPhantom::MemoryPhantom(MemoryPhantom&& other) noexcept
-    : hProcess(other.hProcess), processId(other.processId) {
+    : hProcess(other.hProcess), processId(other.processId), grantedAccess(other.grantedAccess), backend(std::move(other.backend)),
+    cacheEnabled(other.cacheEnabled), cacheTtl(other.cacheTtl), cacheEpoch(other.cacheEpoch.load()),
+    cacheGeneration(other.cacheGeneration.load()), threads(std::move(other.threads)),
+    moduleAutoRefresh(other.moduleAutoRefresh), modules(other.modules.load()), modulesRefreshed(other.modulesRefreshed.load()),
+    regionMapEnabled(other.regionMapEnabled), regionTtl(other.regionTtl), regionMap(std::move(other.regionMap)),
+    regionVersion(other.regionVersion.load()) {
     other.hProcess = nullptr;
     other.processId = 0;
+    other.grantedAccess = 0;
+    other.modules.store(nullptr);
+    // The moved-from object stays usable; its threads get fresh state instead of a null registry
+    other.threads = std::make_shared<ThreadRegistry>();
 }
 
 MemoryPhantom& MemoryPhantom::operator=(MemoryPhantom&& other) noexcept {
@@ -22,32 +36,96 @@ MemoryPhantom& MemoryPhantom::operator=(MemoryPhantom&& other) noexcept {
         Detach();
         hProcess = other.hProcess;
         processId = other.processId;
+        grantedAccess = other.grantedAccess;
+        backend = std::move(other.backend);
+        cacheEnabled = other.cacheEnabled;
+        cacheTtl = other.cacheTtl;
+        cacheEpoch.store(other.cacheEpoch.load());
+        cacheGeneration.store(other.cacheGeneration.load());
+        threads = std::move(other.threads);
+        moduleAutoRefresh = other.moduleAutoRefresh;
+        modules.store(other.modules.load());
+        modulesRefreshed.store(other.modulesRefreshed.load());
+        regionMapEnabled = other.regionMapEnabled;
+        regionTtl = other.regionTtl;
+        regionMap = std::move(other.regionMap);
+        regionVersion.store(other.regionVersion.load());
         other.hProcess = nullptr;
         other.processId = 0;
+        other.grantedAccess = 0;
+        other.modules.store(nullptr);
+        other.threads = std::make_shared<ThreadRegistry>();
     }
     return *this;
 }
 
-bool MemoryPhantom::Attach(DWORD pid, DWORD accessRights) {
+bool MemoryPhantom::Attach(DWORD pid, AccessRequest access) {
     Detach();
-    hProcess = OpenProcess(accessRights, FALSE, pid);
+    if (!threads) threads = std::make_shared<ThreadRegistry>();
+    if (!access.IsProfile()) {
+        hProcess = OpenProcess(access.rights, FALSE, pid);
+        if (hProcess) grantedAccess = access.rights;
+    }
+    else {
+        // Any error other than a denial (no such process, for one) fails the same way with fewer rights
+        for (int level = static_cast<int>(access.preferred); level >= static_cast<int>(access.minimum); level--) {
+            DWORD rights = ProfileRights(static_cast<AccessProfile>(level));
+            hProcess = OpenProcess(rights, FALSE, pid);
+            if (hProcess) {
+                grantedAccess = rights;
+                break;
+            }
+            if (GetLastError() != ERROR_ACCESS_DENIED) break;
+        }
+    }
     if (hProcess) {
         processId = pid;
+        if (regionMapEnabled) RefreshRegionMap();
         return true;
     }
     return false;
 }
 
+bool MemoryPhantom::Attach(DWORD pid, std::shared_ptr<const MemoryBackend> memoryBackend, AccessRequest access) {
+    if (!Attach(pid, access)) return false;
+    backend = std::move(memoryBackend);
+    return true;
+}
+
+bool MemoryPhantom::Attach(std::shared_ptr<const MemoryBackend> memoryBackend) {
+    Detach();
+    if (!memoryBackend) return false;
+    if (!threads) threads = std::make_shared<ThreadRegistry>();
+    backend = std::move(memoryBackend);
+    if (regionMapEnabled) RefreshRegionMap();
+    return true;
+}
+
 void MemoryPhantom::Detach() {
     if (hProcess) {
         CloseHandle(hProcess);
         hProcess = nullptr;
         processId = 0;
     }
+    grantedAccess = 0;
+    backend.reset();
+    cacheGeneration.fetch_add(1, std::memory_order_release);
+    modules.store(nullptr);
+    modulesRefreshed.store(std::chrono::steady_clock::time_point());
+    PublishRegionMap(nullptr);
 }
 
 bool MemoryPhantom::IsActive() const {
-    return hProcess != nullptr;
+    return hProcess != nullptr || backend != nullptr;
+}
+
+std::shared_ptr<const MemoryBackend> MemoryPhantom::GetBackend() const {
+    return backend;
+}
+
+std::span<const uint8_t> MemoryPhantom::View(uintptr_t addr, size_t size) const {
+    if (!backend || addr == 0 || size == 0) return {};
+    return backend->View(addr, size);
 }
 
 DWORD MemoryPhantom::GetPID() const {
@@ -58,567 +136,1104 @@ HANDLE MemoryPhantom::GetHandle() const {
     return hProcess;
 }
 
-std::optional<MemoryPhantom> MemoryPhantom::CreateFromName(const char* processName, DWORD accessRights) {
-    PROCESSENTRY32W entry;
-    entry.dwSize = sizeof(PROCESSENTRY32W);
+DWORD MemoryPhantom::GetGrantedAccess() const {
+    return grantedAccess;
+}
 
-    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (snapshot == INVALID_HANDLE_VALUE) return std::nullopt;
+bool MemoryPhantom::HasAccess(DWORD rights) const {
+    return hProcess != nullptr && (grantedAccess & rights) == rights;
+}
 
-    if (Process32FirstW(snapshot, &entry)) {
-        do {
-            char currentProcessName[MAX_PATH];
-            WideCharToMultiByte(CP_UTF8, 0, entry.szExeFile, -1, currentProcessName, MAX_PATH, NULL, NULL);
-
-            if (_stricmp(currentProcessName, processName) == 0) {
-                CloseHandle(snapshot);
-                MemoryPhantom phantom;
-                if (phantom.Attach(entry.th32ProcessID, accessRights)) {
-                    return phantom;
-                }
-                return std::nullopt;
-            }
-        } while (Process32NextW(snapshot, &entry));
-    }
+std::optional<AccessProfile> MemoryPhantom::GetAccessProfile() const {
+    if (!hProcess) return std::nullopt;
+    return ProfileFor(grantedAccess);
+}
 
-    CloseHandle(snapshot);
-    return std::nullopt;
+std::optional<MemoryPhantom> MemoryPhantom::CreateFromName(const char* processName, AccessRequest access) {
+    ProcessIndex index;
+    if (!processName || !index.Refresh()) return std::nullopt;
+    return CreateFromName(index, ProcessIndex::Widen(processName), access);
 }
 
-std::optional<uintptr_t> MemoryPhantom::FindModuleBase(const char* moduleName) const {
-    if (!hProcess) return std::nullopt;
+std::optional<MemoryPhantom> MemoryPhantom::CreateFromName(const ProcessIndex& index, std::wstring_view processName, AccessRequest access) {
+    return AttachFirst(index.FindAll(processName), access);
+}
 
-    HMODULE hMods[1024];
-    DWORD cbNeeded;
+std::optional<MemoryPhantom> MemoryPhantom::CreateFromModule(const ProcessIndex& index, std::wstring_view moduleName,
+    std::wstring_view processName, AccessRequest access) {
+    return AttachFirst(index.FindByModule(moduleName, processName), access);
+}
 
-    if (EnumProcessModules(hProcess, hMods, sizeof(hMods), &cbNeeded)) {
-        for (unsigned int i = 0; i < cbNeeded / sizeof(HMODULE); i++) {
-            char szModName[MAX_PATH];
-            if (GetModuleFileNameExA(hProcess, hMods[i], szModName, sizeof(szModName))) {
-                const char* baseName = strrchr(szModName, '\\');
-                if (baseName) baseName++;
-                else baseName = szModName;
+std::optional<MemoryPhantom> MemoryPhantom::CreateFromWindowTitle(const ProcessIndex& index, std::wstring_view title, AccessRequest access) {
+    return AttachFirst(index.FindByWindowTitle(title), access);
+}
 
-                if (_stricmp(baseName, moduleName) == 0) {
-                    return reinterpret_cast<uintptr_t>(hMods[i]);
-                }
-            }
-        }
+std::optional<MemoryPhantom> MemoryPhantom::AttachFirst(std::span<const DWORD> pids, AccessRequest access) {
+    for (DWORD pid : pids) {
+        MemoryPhantom phantom;
+        if (phantom.Attach(pid, access)) return phantom;
     }
-
     return std::nullopt;
 }
 
-std::vector<uint8_t> MemoryPhantom::InternalReadBytes(uintptr_t addr, size_t sz) const {
-    std::vector<uint8_t> buffer(sz);
-    if (!hProcess || addr == 0 || sz == 0) return buffer;
+namespace {
+    std::string WideToUtf8(const wchar_t* text) {
+        int length = WideCharToMultiByte(CP_UTF8, 0, text, -1, nullptr, 0, NULL, NULL);
+        if (length <= 1) return std::string();
 
-    SIZE_T bytesRead;
-    if (ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(addr), buffer.data(), sz, &bytesRead) && bytesRead == sz) {
-        return buffer;
+        std::string result(length - 1, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, text, -1, result.data(), length, NULL, NULL);
+        return result;
     }
-    return std::vector<uint8_t>();
-}
 
-int MemoryPhantom::ReadInt(uintptr_t addr) const {
-    int value = 0;
-    InternalRead(addr, value);
-    return value;
-}
+    size_t LowerAscii(const char* text, char* out, size_t capacity) {
+        size_t i = 0;
+        for (; text[i] && i < capacity; i++) {
+            char c = text[i];
+            out[i] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+        return i;
+    }
 
-int MemoryPhantom::ReadInt(uintptr_t addr, int offset) const {
-    return ReadInt(addr + offset);
+    std::string LowerAscii(const std::string& text) {
+        std::string result(text.size(), '\0');
+        LowerAscii(text.c_str(), result.data(), result.size());
+        return result;
+    }
 }
 
-int MemoryPhantom::ReadInt(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadInt(*addr) : 0;
-}
+bool MemoryPhantom::SnapshotModules(std::vector<ModuleInfo>& found) const {
+    HANDLE snapshot = ProcessIndex::CreateModuleSnapshot(processId);
+    if (snapshot == INVALID_HANDLE_VALUE) return false;
 
-int MemoryPhantom::ReadInt(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadInt(*addr + offset) : 0;
-}
+    MODULEENTRY32W entry;
+    entry.dwSize = sizeof(MODULEENTRY32W);
+    if (Module32FirstW(snapshot, &entry)) {
+        do {
+            found.push_back({ reinterpret_cast<uintptr_t>(entry.modBaseAddr), entry.modBaseSize,
+                WideToUtf8(entry.szModule), WideToUtf8(entry.szExePath) });
+        } while (Module32NextW(snapshot, &entry));
+    }
 
-float MemoryPhantom::ReadFloat(uintptr_t addr) const {
-    float value = 0;
-    InternalRead(addr, value);
-    return value;
+    CloseHandle(snapshot);
+    return !found.empty();
 }
 
-float MemoryPhantom::ReadFloat(uintptr_t addr, int offset) const {
-    return ReadFloat(addr + offset);
-}
+bool MemoryPhantom::EnumerateModules(std::vector<ModuleInfo>& found) const {
+    std::vector<HMODULE> handles(1024);
+    DWORD cbNeeded = 0;
+    while (true) {
+        if (!EnumProcessModules(hProcess, handles.data(), static_cast<DWORD>(handles.size() * sizeof(HMODULE)), &cbNeeded)) return false;
+        if (cbNeeded <= handles.size() * sizeof(HMODULE)) break;
+        handles.resize(cbNeeded / sizeof(HMODULE));
+    }
 
-float MemoryPhantom::ReadFloat(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadFloat(*addr) : 0;
-}
+    for (size_t i = 0; i < cbNeeded / sizeof(HMODULE); i++) {
+        char szModName[MAX_PATH];
+        MODULEINFO info;
+        if (!GetModuleFileNameExA(hProcess, handles[i], szModName, sizeof(szModName)) ||
+            !GetModuleInformation(hProcess, handles[i], &info, sizeof(info))) {
+            continue;
+        }
 
-float MemoryPhantom::ReadFloat(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadFloat(*addr + offset) : 0;
-}
+        const char* baseName = strrchr(szModName, '\\');
+        if (baseName) baseName++;
+        else baseName = szModName;
 
-double MemoryPhantom::ReadDouble(uintptr_t addr) const {
-    double value = 0;
-    InternalRead(addr, value);
-    return value;
+        found.push_back({ reinterpret_cast<uintptr_t>(info.lpBaseOfDll), info.SizeOfImage, baseName, szModName });
+    }
+    return !found.empty();
 }
 
-double MemoryPhantom::ReadDouble(uintptr_t addr, int offset) const {
-    return ReadDouble(addr + offset);
-}
+// Readers keep the table they loaded alive, so a refresh on another thread never invalidates their entries
+bool MemoryPhantom::RefreshModules() const {
+    modulesRefreshed.store(std::chrono::steady_clock::now());
+    if (!IsActive()) return false;
 
-double MemoryPhantom::ReadDouble(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadDouble(*addr) : 0;
-}
+    std::vector<ModuleInfo> found;
+    if (!hProcess) found = backend->Modules();
+    else if (!SnapshotModules(found)) EnumerateModules(found);
+    if (found.empty()) return false;
 
-double MemoryPhantom::ReadDouble(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadDouble(*addr + offset) : 0;
+    auto table = std::make_shared<ModuleTable>();
+    for (ModuleInfo& module : found) {
+        std::string key = LowerAscii(module.name);
+        table->emplace(std::move(key), std::move(module));
+    }
+    modules.store(std::move(table));
+    return true;
 }
 
-short MemoryPhantom::ReadShort(uintptr_t addr) const {
-    short value = 0;
-    InternalRead(addr, value);
-    return value;
+void MemoryPhantom::SetModuleAutoRefresh(bool enabled) {
+    moduleAutoRefresh = enabled;
 }
 
-short MemoryPhantom::ReadShort(uintptr_t addr, int offset) const {
-    return ReadShort(addr + offset);
-}
+std::shared_ptr<const MemoryPhantom::ModuleInfo> MemoryPhantom::LookupModule(const char* moduleName) const {
+    if (!IsActive() || !moduleName) return nullptr;
 
-short MemoryPhantom::ReadShort(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadShort(*addr) : 0;
-}
+    char key[MAX_PATH];
+    std::string_view name(key, LowerAscii(moduleName, key, sizeof(key)));
 
-short MemoryPhantom::ReadShort(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadShort(*addr + offset) : 0;
-}
+    std::shared_ptr<const ModuleTable> table = modules.load();
+    if (table) {
+        auto it = table->find(name);
+        if (it != table->end()) return std::shared_ptr<const ModuleInfo>(table, &it->second);
+    }
 
-unsigned short MemoryPhantom::ReadUShort(uintptr_t addr) const {
-    unsigned short value = 0;
-    InternalRead(addr, value);
-    return value;
+    auto refreshed = modulesRefreshed.load();
+    bool neverLoaded = refreshed == std::chrono::steady_clock::time_point();
+    if (neverLoaded || (moduleAutoRefresh && std::chrono::steady_clock::now() - refreshed >= ModuleRefreshInterval)) {
+        if (RefreshModules()) {
+            table = modules.load();
+            auto it = table->find(name);
+            if (it != table->end()) return std::shared_ptr<const ModuleInfo>(table, &it->second);
+        }
+    }
+    return nullptr;
 }
 
-unsigned short MemoryPhantom::ReadUShort(uintptr_t addr, int offset) const {
-    return ReadUShort(addr + offset);
+std::optional<uintptr_t> MemoryPhantom::FindModuleBase(const char* moduleName) const {
+    auto module = LookupModule(moduleName);
+    return module ? std::optional<uintptr_t>(module->base) : std::nullopt;
 }
 
-unsigned short MemoryPhantom::ReadUShort(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadUShort(*addr) : 0;
+std::optional<MemoryPhantom::ModuleInfo> MemoryPhantom::FindModule(const char* moduleName) const {
+    auto module = LookupModule(moduleName);
+    return module ? std::optional<ModuleInfo>(*module) : std::nullopt;
 }
 
-unsigned short MemoryPhantom::ReadUShort(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadUShort(*addr + offset) : 0;
-}
+std::vector<MemoryPhantom::ModuleInfo> MemoryPhantom::GetModules() const {
+    std::shared_ptr<const ModuleTable> table = modules.load();
+    if (!table) {
+        RefreshModules();
+        table = modules.load();
+    }
 
-unsigned int MemoryPhantom::ReadUInt(uintptr_t addr) const {
-    unsigned int value = 0;
-    InternalRead(addr, value);
-    return value;
-}
+    std::vector<ModuleInfo> result;
+    if (!table) return result;
+    result.reserve(table->size());
+    for (const auto& entry : *table) result.push_back(entry.second);
+    std::sort(result.begin(), result.end(), [](const ModuleInfo& a, const ModuleInfo& b) { return a.base < b.base; });
+    return result;
+}
+
+std::vector<MemoryRegion> MemoryPhantom::QueryRegions(uintptr_t start, uintptr_t end, bool readableOnly) const {
+    std::vector<MemoryRegion> regions;
+    if (!hProcess) {
+        if (!backend) return regions;
+        for (const MemoryRegion& region : backend->Regions()) {
+            if (region.End() <= start || region.base >= end) continue;
+            if (!readableOnly || region.IsReadable()) regions.push_back(region);
+        }
+        return regions;
+    }
 
-unsigned int MemoryPhantom::ReadUInt(uintptr_t addr, int offset) const {
-    return ReadUInt(addr + offset);
-}
+    MEMORY_BASIC_INFORMATION mbi;
+    uintptr_t addr = start;
+    while (addr < end && VirtualQueryEx(hProcess, reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) == sizeof(mbi)) {
+        MemoryRegion region{ reinterpret_cast<uintptr_t>(mbi.BaseAddress), mbi.RegionSize, mbi.State, mbi.Protect, mbi.Type };
+        if (region.size == 0 || region.End() <= addr) break;
 
-unsigned int MemoryPhantom::ReadUInt(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadUInt(*addr) : 0;
+        if (!readableOnly || region.IsReadable()) {
+            regions.push_back(region);
+        }
+        addr = region.End();
+    }
+    return regions;
 }
 
-unsigned int MemoryPhantom::ReadUInt(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadUInt(*addr + offset) : 0;
+bool MemoryPhantom::EnableRegionMap(std::chrono::milliseconds ttl) {
+    regionMapEnabled = true;
+    regionTtl = ttl;
+    return RefreshRegionMap();
 }
 
-uint64_t MemoryPhantom::ReadULong(uintptr_t addr) const {
-    uint64_t value = 0;
-    InternalRead(addr, value);
-    return value;
+void MemoryPhantom::DisableRegionMap() {
+    regionMapEnabled = false;
+    PublishRegionMap(nullptr);
 }
 
-uint64_t MemoryPhantom::ReadULong(uintptr_t addr, int offset) const {
-    return ReadULong(addr + offset);
+bool MemoryPhantom::IsRegionMapEnabled() const {
+    return regionMapEnabled;
 }
 
-uint64_t MemoryPhantom::ReadULong(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadULong(*addr) : 0;
-}
+bool MemoryPhantom::RefreshRegionMap() const {
+    if (!IsActive()) return false;
 
-uint64_t MemoryPhantom::ReadULong(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadULong(*addr + offset) : 0;
+    std::vector<MemoryRegion> regions = QueryRegions(0, UINTPTR_MAX, false);
+    if (regions.empty()) return false;
+    PublishRegionMap(std::make_shared<const RegionMap>(std::move(regions), RegionMap::Clock::now()));
+    return true;
 }
 
-int64_t MemoryPhantom::ReadLong(uintptr_t addr) const {
-    int64_t value = 0;
-    InternalRead(addr, value);
-    return value;
+// Re-queries only the regions overlapping the range and splices them into the current map
+bool MemoryPhantom::RefreshRegionMap(uintptr_t start, size_t size) const {
+    if (!IsActive()) return false;
+
+    uintptr_t end = start + std::min<size_t>(std::max<size_t>(size, 1), UINTPTR_MAX - start);
+    std::vector<MemoryRegion> regions = QueryRegions(start, end, false);
+    if (regions.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    if (!regionMap) return false;
+    regionMap = std::make_shared<const RegionMap>(regionMap->Splice(start, end, regions, RegionMap::Clock::now()));
+    regionVersion.fetch_add(1, std::memory_order_release);
+    return true;
 }
 
-int64_t MemoryPhantom::ReadLong(uintptr_t addr, int offset) const {
-    return ReadLong(addr + offset);
+std::shared_ptr<const RegionMap> MemoryPhantom::GetRegionMap() const {
+    std::lock_guard<std::mutex> lock(regionMutex);
+    return regionMap;
 }
 
-int64_t MemoryPhantom::ReadLong(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadLong(*addr) : 0;
+void MemoryPhantom::PublishRegionMap(std::shared_ptr<const RegionMap> map) const {
+    std::lock_guard<std::mutex> lock(regionMutex);
+    regionMap = std::move(map);
+    regionVersion.fetch_add(1, std::memory_order_release);
 }
 
-int64_t MemoryPhantom::ReadLong(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadLong(*addr + offset) : 0;
+const RegionMap* MemoryPhantom::LocalRegions(ThreadState& state) const {
+    uint64_t version = regionVersion.load(std::memory_order_acquire);
+    if (state.regionVersion != version) {
+        std::lock_guard<std::mutex> lock(regionMutex);
+        state.regions = regionMap;
+        state.regionVersion = regionVersion.load(std::memory_order_relaxed);
+    }
+    return state.regions.get();
+}
+
+// A range the map calls unreadable is only re-queried once its entries are older than the TTL
+bool MemoryPhantom::RegionAllows(ThreadState& state, uintptr_t addr, size_t sz) const {
+    const RegionMap* map = LocalRegions(state);
+    if (!map || map->IsReadable(addr, sz)) return true;
+    if (RegionMap::Clock::now() - map->Verified(addr, sz) < regionTtl) return false;
+
+    // Every splice copies the whole map, so a batch full of expired misses must not refresh for each one
+    if (state.regionRefreshBudget == 0) return false;
+    if (state.regionRefreshBudget != SIZE_MAX) state.regionRefreshBudget--;
+    RefreshRegionMap(addr, sz);
+    map = LocalRegions(state);
+    return !map || map->IsReadable(addr, sz);
+}
+
+template<typename Results>
+bool MemoryPhantom::InternalPatternScan(uintptr_t start, size_t size, uintptr_t boundEnd, const BytePattern& pattern, size_t chunkSize,
+    Results& results, bool firstOnly, std::pmr::memory_resource* resource) const {
+    const size_t overlap = pattern.Size() - 1;
+    std::pmr::vector<uint8_t> buffer(std::min(size, chunkSize) + overlap, resource);
+
+    for (size_t offset = 0; offset < size; offset += chunkSize) {
+        uintptr_t chunkStart = start + offset;
+        size_t own = std::min(chunkSize, size - offset);
+        size_t readLength = std::min(own + overlap, static_cast<size_t>(boundEnd - chunkStart));
+
+        if (!InternalReadDirect(chunkStart, buffer.data(), readLength)) {
+            if (chunkSize > PageSize) {
+                if (InternalPatternScan(chunkStart, own, boundEnd, pattern, PageSize, results, firstOnly, resource)) return true;
+                continue;
+            }
+            // The overlap may reach into an unreadable page; matches that fit in this page are still found
+            if (readLength == own || !InternalReadDirect(chunkStart, buffer.data(), own)) continue;
+            readLength = own;
+        }
+
+        for (size_t pos = pattern.Find(buffer.data(), readLength); pos != BytePattern::npos && pos < own;
+            pos = pattern.Find(buffer.data(), readLength, pos + 1)) {
+            results.push_back(chunkStart + pos);
+            if (firstOnly) return true;
+        }
+    }
+    return false;
 }
 
-bool MemoryPhantom::ReadBool(uintptr_t addr) const {
-    bool value = false;
-    InternalRead(addr, value);
-    return value;
+std::optional<uintptr_t> MemoryPhantom::PatternScan(const char* moduleName, const char* pattern) const {
+    auto module = LookupModule(moduleName);
+    return module ? PatternScan(module->base, module->size, pattern) : std::nullopt;
 }
 
-bool MemoryPhantom::ReadBool(uintptr_t addr, int offset) const {
-    return ReadBool(addr + offset);
+std::optional<uintptr_t> MemoryPhantom::PatternScan(uintptr_t start, size_t size, const char* pattern) const {
+    auto parsed = BytePattern::Parse(pattern);
+    return parsed ? PatternScan(start, size, *parsed) : std::nullopt;
 }
 
-bool MemoryPhantom::ReadBool(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadBool(*addr) : false;
+std::optional<uintptr_t> MemoryPhantom::PatternScan(uintptr_t start, size_t size, const BytePattern& pattern) const {
+    if (!IsActive() || start == 0 || pattern.Size() == 0 || size < pattern.Size()) return std::nullopt;
+
+    std::vector<uintptr_t> results;
+    size_t starts = size - pattern.Size() + 1;
+    if (!InternalPatternScan(start, starts, start + size, pattern, PatternChunkSize, results, true, std::pmr::get_default_resource())) {
+        return std::nullopt;
+    }
+    return results.front();
 }
 
-bool MemoryPhantom::ReadBool(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadBool(*addr + offset) : false;
+std::vector<uintptr_t> MemoryPhantom::PatternScanAll(const char* moduleName, const char* pattern) const {
+    auto module = LookupModule(moduleName);
+    auto parsed = BytePattern::Parse(pattern);
+    if (!module || !parsed) return std::vector<uintptr_t>();
+    return PatternScanAll(module->base, module->size, *parsed);
 }
 
-char MemoryPhantom::ReadChar(uintptr_t addr) const {
-    char value = 0;
-    InternalRead(addr, value);
-    return value;
+std::vector<uintptr_t> MemoryPhantom::PatternScanAll(uintptr_t start, size_t size, const BytePattern& pattern) const {
+    std::vector<uintptr_t> results;
+    if (!IsActive() || start == 0 || pattern.Size() == 0 || size < pattern.Size()) return results;
+
+    size_t starts = size - pattern.Size() + 1;
+    InternalPatternScan(start, starts, start + size, pattern, PatternChunkSize, results, false, std::pmr::get_default_resource());
+    return results;
 }
 
-char MemoryPhantom::ReadChar(uintptr_t addr, int offset) const {
-    return ReadChar(addr + offset);
+std::pmr::vector<uintptr_t> MemoryPhantom::PatternScanAll(uintptr_t start, size_t size, const BytePattern& pattern,
+    std::pmr::memory_resource* resource) const {
+    if (!resource) resource = std::pmr::get_default_resource();
+    std::pmr::vector<uintptr_t> results(resource);
+    if (!IsActive() || start == 0 || pattern.Size() == 0 || size < pattern.Size()) return results;
+
+    size_t starts = size - pattern.Size() + 1;
+    InternalPatternScan(start, starts, start + size, pattern, PatternChunkSize, results, false, resource);
+    return results;
 }
 
-char MemoryPhantom::ReadChar(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadChar(*addr) : 0;
+void MemoryPhantom::EnableReadCache(std::chrono::milliseconds ttl) {
+    cacheEnabled = true;
+    cacheTtl = ttl;
 }
 
-char MemoryPhantom::ReadChar(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadChar(*addr + offset) : 0;
+void MemoryPhantom::DisableReadCache() {
+    cacheEnabled = false;
+    cacheGeneration.fetch_add(1, std::memory_order_release);
 }
 
-uint8_t MemoryPhantom::ReadByte(uintptr_t addr) const {
-    uint8_t value = 0;
-    InternalRead(addr, value);
-    return value;
+bool MemoryPhantom::IsReadCacheEnabled() const {
+    return cacheEnabled;
 }
 
-uint8_t MemoryPhantom::ReadByte(uintptr_t addr, int offset) const {
-    return ReadByte(addr + offset);
+void MemoryPhantom::BeginFrame() const {
+    cacheEpoch.fetch_add(1, std::memory_order_relaxed);
 }
 
-uint8_t MemoryPhantom::ReadByte(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadByte(*addr) : 0;
+uint64_t MemoryPhantom::GetEpoch() const {
+    return cacheEpoch.load(std::memory_order_relaxed);
 }
 
-uint8_t MemoryPhantom::ReadByte(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadByte(*addr + offset) : 0;
+void MemoryPhantom::InvalidateCache() const {
+    cacheGeneration.fetch_add(1, std::memory_order_release);
 }
 
-std::string MemoryPhantom::ReadString(uintptr_t addr, size_t length) const {
-    if (!hProcess || addr == 0 || length == 0) return "";
+MemoryPhantom::CacheStats MemoryPhantom::GetCacheStats() const {
+    CacheStats stats{ 0, 0, 0 };
+    if (!threads) return stats;
 
-    std::vector<char> buffer(length + 1);
-    SIZE_T bytesRead;
-    if (ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(addr), buffer.data(), length, &bytesRead)) {
-        buffer[length] = '\0';
-        return std::string(buffer.data());
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    for (const auto& state : threads->states) {
+        stats.hits += state->cacheHits.load(std::memory_order_relaxed);
+        stats.misses += state->cacheMisses.load(std::memory_order_relaxed);
+        stats.pages += state->pageCount.load(std::memory_order_relaxed);
     }
-    return "";
+    return stats;
 }
 
-std::string MemoryPhantom::ReadString(uintptr_t addr, int offset, size_t length) const {
-    return ReadString(addr + offset, length);
-}
+void MemoryPhantom::ResetCacheStats() {
+    if (!threads) return;
 
-std::string MemoryPhantom::ReadString(const std::optional<uintptr_t>& addr, size_t length) const {
-    return addr ? ReadString(*addr, length) : "";
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    for (const auto& state : threads->states) {
+        state->cacheHits.store(0, std::memory_order_relaxed);
+        state->cacheMisses.store(0, std::memory_order_relaxed);
+    }
 }
 
-std::string MemoryPhantom::ReadString(const std::optional<uintptr_t>& addr, int offset, size_t length) const {
-    return addr ? ReadString(*addr + offset, length) : "";
+std::vector<MemoryPhantom::ThreadStats> MemoryPhantom::GetThreadStats() const {
+    std::vector<ThreadStats> result;
+    if (!threads) return result;
+
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    for (const auto& state : threads->states) {
+        result.push_back({ state->thread, state->alive.load(std::memory_order_relaxed),
+            state->reads.load(std::memory_order_relaxed), state->bytesRead.load(std::memory_order_relaxed),
+            state->writes.load(std::memory_order_relaxed), state->bytesWritten.load(std::memory_order_relaxed),
+            state->cacheHits.load(std::memory_order_relaxed), state->cacheMisses.load(std::memory_order_relaxed),
+            state->pageCount.load(std::memory_order_relaxed), state->skippedReads.load(std::memory_order_relaxed) });
+    }
+    return result;
 }
 
-std::wstring MemoryPhantom::ReadWString(uintptr_t addr, size_t length) const {
-    if (!hProcess || addr == 0 || length == 0) return L"";
+uint64_t MemoryPhantom::LatencyHistogram::PercentileNs(double fraction) const {
+    if (calls == 0) return 0;
 
-    size_t byteLength = length * sizeof(wchar_t);
-    std::vector<wchar_t> buffer(length + 1);
-    SIZE_T bytesRead;
-    if (ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(addr), buffer.data(), byteLength, &bytesRead)) {
-        buffer[length] = L'\0';
-        return std::wstring(buffer.data());
+    uint64_t target = static_cast<uint64_t>(std::clamp(fraction, 0.0, 1.0) * calls);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < Buckets; i++) {
+        seen += counts[i];
+        if (seen > target || seen == calls) return i + 1 < Buckets ? std::min((uint64_t(1) << (i + 1)) - 1, maxNs) : maxNs;
     }
-    return L"";
+    return maxNs;
 }
 
-std::wstring MemoryPhantom::ReadWString(uintptr_t addr, int offset, size_t length) const {
-    return ReadWString(addr + offset, length);
-}
+MemoryPhantom::OperationStats MemoryPhantom::GetOperationStats() const {
+    OperationStats stats{};
+    if (!threads) return stats;
 
-std::wstring MemoryPhantom::ReadWString(const std::optional<uintptr_t>& addr, size_t length) const {
-    return addr ? ReadWString(*addr, length) : L"";
-}
+    std::lock_guard<std::mutex> lock(threads->mutex);
+#if defined(PHANTOM_STATS)
+    std::unordered_map<DWORD, uint64_t> errors;
+    auto merge = [](LatencyHistogram& histogram, const OperationCounters& counters) {
+        for (size_t i = 0; i < LatencyHistogram::Buckets; i++) {
+            uint64_t count = counters.buckets[i].load(std::memory_order_relaxed);
+            histogram.counts[i] += count;
+            histogram.calls += count;
+        }
+        histogram.totalNs += counters.totalNs.load(std::memory_order_relaxed);
+        histogram.maxNs = std::max(histogram.maxNs, counters.maxNs.load(std::memory_order_relaxed));
+    };
+#endif
+
+    for (const auto& state : threads->states) {
+        stats.reads += state->reads.load(std::memory_order_relaxed);
+        stats.bytesRead += state->bytesRead.load(std::memory_order_relaxed);
+        stats.writes += state->writes.load(std::memory_order_relaxed);
+        stats.bytesWritten += state->bytesWritten.load(std::memory_order_relaxed);
+#if defined(PHANTOM_STATS)
+        stats.readFailures += state->readOps.failures.load(std::memory_order_relaxed);
+        stats.writeFailures += state->writeOps.failures.load(std::memory_order_relaxed);
+        merge(stats.readLatency, state->readOps);
+        merge(stats.writeLatency, state->writeOps);
+        for (size_t slot = 0; slot < ErrorSlots; slot++) {
+            uint64_t count = state->errorCounts[slot].load(std::memory_order_acquire);
+            if (count > 0) errors[state->errorCodes[slot].load(std::memory_order_relaxed)] += count;
+        }
+        stats.otherErrors += state->otherErrors.load(std::memory_order_relaxed);
+#endif
+    }
 
-std::wstring MemoryPhantom::ReadWString(const std::optional<uintptr_t>& addr, int offset, size_t length) const {
-    return addr ? ReadWString(*addr + offset, length) : L"";
+#if defined(PHANTOM_STATS)
+    for (const auto& [code, count] : errors) stats.errors.push_back({ code, count });
+    std::sort(stats.errors.begin(), stats.errors.end(), [](const ErrorCount& a, const ErrorCount& b) {
+        return a.count != b.count ? a.count > b.count : a.code < b.code;
+    });
+#endif
+    return stats;
+}
+
+// Also clears the read/write counters reported by GetThreadStats
+void MemoryPhantom::ResetOperationStats() {
+    if (!threads) return;
+
+    std::lock_guard<std::mutex> lock(threads->mutex);
+    for (const auto& state : threads->states) {
+        state->reads.store(0, std::memory_order_relaxed);
+        state->bytesRead.store(0, std::memory_order_relaxed);
+        state->writes.store(0, std::memory_order_relaxed);
+        state->bytesWritten.store(0, std::memory_order_relaxed);
+#if defined(PHANTOM_STATS)
+        for (OperationCounters* counters : { &state->readOps, &state->writeOps }) {
+            counters->failures.store(0, std::memory_order_relaxed);
+            counters->totalNs.store(0, std::memory_order_relaxed);
+            counters->maxNs.store(0, std::memory_order_relaxed);
+            for (auto& bucket : counters->buckets) bucket.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : state->errorCounts) count.store(0, std::memory_order_relaxed);
+        state->otherErrors.store(0, std::memory_order_relaxed);
+#endif
+    }
 }
 
-Vector3 MemoryPhantom::ReadVec3(uintptr_t addr) const {
-    Vector3 vec;
-    if (InternalRead(addr, vec)) return vec;
-    return Vector3(0, 0, 0);
-}
+#if defined(PHANTOM_STATS)
+// error is the code the caller already derived, so a short read counts as ERROR_PARTIAL_COPY
+void MemoryPhantom::RecordOperation(ThreadState& state, OperationCounters& counters, std::chrono::steady_clock::time_point started, DWORD error) {
+    bool success = error == ERROR_SUCCESS;
+    uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+
+    size_t bucket = std::min<size_t>(ns ? std::bit_width(ns) - 1 : 0, LatencyHistogram::Buckets - 1);
+    counters.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    counters.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > counters.maxNs.load(std::memory_order_relaxed)) counters.maxNs.store(ns, std::memory_order_relaxed);
+    if (success) return;
+
+    counters.failures.fetch_add(1, std::memory_order_relaxed);
+    for (size_t slot = 0; slot < ErrorSlots; slot++) {
+        uint64_t count = state.errorCounts[slot].load(std::memory_order_relaxed);
+        if (count == 0) {
+            state.errorCodes[slot].store(error, std::memory_order_relaxed);
+            state.errorCounts[slot].store(1, std::memory_order_release);
+            return;
+        }
+        if (state.errorCodes[slot].load(std::memory_order_relaxed) == error) {
+            state.errorCounts[slot].fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    state.otherErrors.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+// Each thread keeps its own page cache and counters, found without locking after the first call from that thread
+MemoryPhantom::ThreadState& MemoryPhantom::LocalState() const {
+    struct Slot {
+        const ThreadRegistry* key = nullptr;
+        std::weak_ptr<ThreadRegistry> owner;
+        std::shared_ptr<ThreadState> state;
+
+        Slot() = default;
+        Slot(Slot&&) = default;
+        Slot& operator=(Slot&&) = default;
+        ~Slot() {
+            if (!state) return;
+            state->pages.clear();
+            state->pageCount.store(0, std::memory_order_relaxed);
+            state->arena.Release();
+            state->alive.store(false, std::memory_order_relaxed);
+        }
+    };
+    thread_local std::vector<Slot> slots;
 
-Vector3 MemoryPhantom::ReadVec3(uintptr_t addr, int offset) const {
-    return ReadVec3(addr + offset);
-}
+    const ThreadRegistry* key = threads.get();
+    for (Slot& slot : slots) {
+        if (slot.key == key && !slot.owner.expired()) return *slot.state;
+    }
 
-Vector3 MemoryPhantom::ReadVec3(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadVec3(*addr) : Vector3(0, 0, 0);
+    slots.erase(std::remove_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.owner.expired(); }), slots.end());
+
+    Slot slot;
+    slot.key = key;
+    slot.owner = threads;
+    slot.state = std::make_shared<ThreadState>();
+    slot.state->thread = std::this_thread::get_id();
+    slot.state->generation = cacheGeneration.load(std::memory_order_acquire);
+    {
+        std::lock_guard<std::mutex> lock(threads->mutex);
+        // States of exited threads are kept for GetThreadStats only until the next thread registers
+        std::erase_if(threads->states, [](const std::shared_ptr<ThreadState>& state) { return !state->alive.load(std::memory_order_relaxed); });
+        threads->states.push_back(slot.state);
+    }
+    slots.push_back(std::move(slot));
+    return *slots.back().state;
 }
 
-Vector3 MemoryPhantom::ReadVec3(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadVec3(*addr + offset) : Vector3(0, 0, 0);
-}
+const MemoryPhantom::CachedPage* MemoryPhantom::FetchPage(ThreadState& state, uintptr_t page) const {
+    auto now = cacheTtl.count() > 0 ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    uint64_t epoch = cacheEpoch.load(std::memory_order_relaxed);
+    uint64_t written = WriteVersion(page).load(std::memory_order_acquire);
 
-std::optional<MemoryPhantom::Mat4x4> MemoryPhantom::ReadMatrix(uintptr_t addr) const {
-    Mat4x4 matrix;
-    if (InternalRead(addr, matrix)) return matrix;
-    return std::nullopt;
-}
+    std::unique_ptr<CachedPage>& cached = state.pages[page];
+    if (cached && cached->epoch == epoch && cached->written == written && (cacheTtl.count() <= 0 || now - cached->fetched < cacheTtl)) {
+        state.cacheHits.fetch_add(1, std::memory_order_relaxed);
+        return cached.get();
+    }
 
-std::optional<MemoryPhantom::Mat4x4> MemoryPhantom::ReadMatrix(uintptr_t addr, int offset) const {
-    return ReadMatrix(addr + offset);
-}
+    if (!cached) {
+        cached = std::make_unique<CachedPage>();
+        state.pageCount.store(state.pages.size(), std::memory_order_relaxed);
+    }
+    state.cacheMisses.fetch_add(1, std::memory_order_relaxed);
+
+    cached->epoch = epoch;
+    cached->written = written;
+    cached->fetched = now;
+    InternalReadDirect(page, cached->data, PageSize, cached->error);
+    return cached.get();
+}
+
+size_t MemoryPhantom::InternalReadCached(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const {
+    ThreadState& state = LocalState();
+    uint64_t generation = cacheGeneration.load(std::memory_order_acquire);
+    if (state.generation != generation) {
+        state.pages.clear();
+        state.pageCount.store(0, std::memory_order_relaxed);
+        state.generation = generation;
+    }
 
-std::optional<MemoryPhantom::Mat4x4> MemoryPhantom::ReadMatrix(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadMatrix(*addr) : std::nullopt;
-}
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    uintptr_t end = addr + sz;
 
-std::optional<MemoryPhantom::Mat4x4> MemoryPhantom::ReadMatrix(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadMatrix(*addr + offset) : std::nullopt;
-}
+    for (uintptr_t page = addr & ~(PageSize - 1); page < end; page += PageSize) {
+        const CachedPage* cached = FetchPage(state, page);
+        uintptr_t from = std::max(addr, page);
+        if (cached->error != ERROR_SUCCESS) {
+            error = cached->error;
+            return from - addr;
+        }
 
-uintptr_t MemoryPhantom::ReadPtr(uintptr_t addr) const {
-    uintptr_t value = 0;
-    InternalRead(addr, value);
-    return value;
+        uintptr_t to = std::min(end, page + PageSize);
+        memcpy(out + (from - addr), cached->data + (from - page), to - from);
+    }
+    error = ERROR_SUCCESS;
+    return sz;
 }
 
-uintptr_t MemoryPhantom::ReadPtr(uintptr_t addr, int offset) const {
-    return ReadPtr(addr + offset);
-}
+// Published after the write, so a page fetched concurrently either sees the new bytes or the new version
+void MemoryPhantom::PublishWrite(uintptr_t addr, size_t sz) const {
+    if (!cacheEnabled) return;
 
-uintptr_t MemoryPhantom::ReadPtr(const std::optional<uintptr_t>& addr) const {
-    return addr ? ReadPtr(*addr) : 0;
+    uintptr_t first = addr / PageSize;
+    uintptr_t last = (addr + (sz - 1)) / PageSize;
+    if (addr + (sz - 1) < addr || last - first >= WriteVersionSlots) {
+        cacheGeneration.fetch_add(1, std::memory_order_release);
+        return;
+    }
+    for (uintptr_t page = first; page <= last; page++) {
+        threads->writeVersions[page % WriteVersionSlots].fetch_add(1, std::memory_order_release);
+    }
 }
 
-uintptr_t MemoryPhantom::ReadPtr(const std::optional<uintptr_t>& addr, int offset) const {
-    return addr ? ReadPtr(*addr + offset) : 0;
+bool MemoryPhantom::InternalReadDirect(uintptr_t addr, void* buffer, size_t sz) const {
+    DWORD error;
+    InternalReadDirect(addr, buffer, sz, error);
+    return error == ERROR_SUCCESS;
 }
 
-std::vector<uint8_t> MemoryPhantom::ReadBytes(uintptr_t addr, size_t sz) const {
-    return InternalReadBytes(addr, sz);
-}
+// Returns the number of leading bytes copied, which is sz exactly when error is ERROR_SUCCESS
+size_t MemoryPhantom::InternalReadDirect(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const {
+    error = ERROR_SUCCESS;
+    if (backend && backend->Read(addr, buffer, sz)) return sz;
+    if (!hProcess) {
+        error = ERROR_INVALID_HANDLE;
+        return 0;
+    }
 
-std::vector<uint8_t> MemoryPhantom::ReadBytes(uintptr_t addr, int offset, size_t sz) const {
-    return InternalReadBytes(addr + offset, sz);
-}
+    ThreadState& state = LocalState();
+    if (regionMapEnabled && !RegionAllows(state, addr, sz)) {
+        state.skippedReads.fetch_add(1, std::memory_order_relaxed);
+        error = ERROR_NOACCESS;
+        return 0;
+    }
 
-std::vector<uint8_t> MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, size_t sz) const {
-    return addr ? ReadBytes(*addr, sz) : std::vector<uint8_t>();
+#if defined(PHANTOM_STATS)
+    auto started = std::chrono::steady_clock::now();
+#endif
+    SIZE_T bytesRead = 0;
+    BOOL returned = ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(addr), buffer, sz, &bytesRead);
+    bool success = returned && bytesRead == sz;
+    if (!success) error = returned ? ERROR_PARTIAL_COPY : GetLastError();
+#if defined(PHANTOM_STATS)
+    RecordOperation(state, state.readOps, started, error);
+#endif
+    state.reads.fetch_add(1, std::memory_order_relaxed);
+    state.bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+    return success ? sz : std::min<size_t>(bytesRead, sz);
+}
+
+bool MemoryPhantom::InternalReadRaw(uintptr_t addr, void* buffer, size_t sz) const {
+    DWORD error;
+    InternalReadRaw(addr, buffer, sz, error);
+    return error == ERROR_SUCCESS;
+}
+
+size_t MemoryPhantom::InternalReadRaw(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const {
+    if (!IsActive() || addr == 0 || sz == 0) {
+        error = !IsActive() ? ERROR_INVALID_HANDLE : addr == 0 ? ERROR_INVALID_ADDRESS : ERROR_INVALID_PARAMETER;
+        return 0;
+    }
+    if (cacheEnabled && sz <= CacheMaxRead) return InternalReadCached(addr, buffer, sz, error);
+    return InternalReadDirect(addr, buffer, sz, error);
 }
 
-std::vector<uint8_t> MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, int offset, size_t sz) const {
-    return addr ? ReadBytes(*addr + offset, sz) : std::vector<uint8_t>();
-}
+bool MemoryPhantom::InternalWriteRaw(uintptr_t addr, const void* buffer, size_t sz) const {
+    if (!IsActive() || addr == 0 || sz == 0) return false;
 
-bool MemoryPhantom::WriteInt(uintptr_t addr, int value) const {
-    return InternalWrite(addr, value);
+    ThreadState& state = LocalState();
+    if (backend && backend->Write(addr, buffer, sz)) {
+        PublishWrite(addr, sz);
+        return true;
+    }
+    if (!hProcess) return false;
+
+#if defined(PHANTOM_STATS)
+    auto started = std::chrono::steady_clock::now();
+#endif
+    SIZE_T bytesWritten = 0;
+    BOOL returned = WriteProcessMemory(hProcess, reinterpret_cast<LPVOID>(addr), buffer, sz, &bytesWritten);
+    bool success = returned && bytesWritten == sz;
+    // A partial write still changed some bytes
+    PublishWrite(addr, sz);
+#if defined(PHANTOM_STATS)
+    RecordOperation(state, state.writeOps, started, success ? ERROR_SUCCESS : returned ? ERROR_PARTIAL_COPY : GetLastError());
+#endif
+    state.writes.fetch_add(1, std::memory_order_relaxed);
+    state.bytesWritten.fetch_add(bytesWritten, std::memory_order_relaxed);
+    return success;
 }
 
-bool MemoryPhantom::WriteInt(uintptr_t addr, int offset, int value) const {
-    return WriteInt(addr + offset, value);
-}
+std::vector<uint8_t> MemoryPhantom::InternalReadBytes(uintptr_t addr, size_t sz) const {
+    if (!IsActive() || addr == 0 || sz == 0) return std::vector<uint8_t>();
 
-bool MemoryPhantom::WriteInt(const std::optional<uintptr_t>& addr, int value) const {
-    return addr ? WriteInt(*addr, value) : false;
+    std::vector<uint8_t> buffer(sz);
+    if (InternalReadRaw(addr, buffer.data(), sz)) {
+        return buffer;
+    }
+    return std::vector<uint8_t>();
 }
 
-bool MemoryPhantom::WriteInt(const std::optional<uintptr_t>& addr, int offset, int value) const {
-    return addr ? WriteInt(*addr + offset, value) : false;
-}
+// Returns the length in units up to the first terminator, or as far as the string could be read when error is set
+size_t MemoryPhantom::InternalReadTerminated(uintptr_t addr, void* buffer, size_t maxUnits, size_t unitSize, DWORD& error) const {
+    error = ERROR_SUCCESS;
+    if (maxUnits == 0) {
+        error = ERROR_INVALID_PARAMETER;
+        return 0;
+    }
 
-bool MemoryPhantom::WriteFloat(uintptr_t addr, float value) const {
-    return InternalWrite(addr, value);
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    const size_t total = maxUnits * unitSize;
+    size_t done = 0;
+    while (done < total) {
+        uintptr_t at = addr + done;
+        size_t step = std::min(total - done, PageSize - at % PageSize);
+        step -= step % unitSize;
+        if (step == 0) step = unitSize;
+
+        size_t read = InternalReadRaw(at, out + done, step, error);
+        read -= read % unitSize;
+
+        for (size_t i = done; i < done + read; i += unitSize) {
+            bool terminator = true;
+            for (size_t b = 0; b < unitSize; b++) terminator &= out[i + b] == 0;
+            if (terminator) {
+                error = ERROR_SUCCESS;
+                return i / unitSize;
+            }
+        }
+        done += read;
+        if (error != ERROR_SUCCESS) break;
+    }
+    return done / unitSize;
 }
 
-bool MemoryPhantom::WriteFloat(uintptr_t addr, int offset, float value) const {
-    return WriteFloat(addr + offset, value);
-}
+size_t MemoryPhantom::InternalReadScatter(std::span<ReadRequest> requests, std::vector<uint32_t>& order, std::vector<uint8_t>& scratch) const {
+    order.clear();
+    for (uint32_t i = 0; i < requests.size(); i++) {
+        requests[i].success = false;
+        if (requests[i].addr != 0 && requests[i].size != 0 && requests[i].dest) {
+            order.push_back(i);
+        }
+    }
+    if (!IsActive() || order.empty()) return 0;
+
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return requests[a].addr < requests[b].addr;
+    });
+
+    // A refresh during the fallback reads replaces state.regions, so keep this map alive for the whole batch
+    ThreadState& state = LocalState();
+    std::shared_ptr<const RegionMap> regions;
+    if (regionMapEnabled) {
+        LocalRegions(state);
+        regions = state.regions;
+    }
+    struct RefreshBudget {
+        ThreadState& state;
+        size_t previous;
+        ~RefreshBudget() { state.regionRefreshBudget = previous; }
+    } budget{ state, state.regionRefreshBudget };
+    state.regionRefreshBudget = std::min(state.regionRefreshBudget, BatchRegionRefreshes);
+
+    size_t succeeded = 0;
+    size_t first = 0;
+    while (first < order.size()) {
+        uintptr_t start = requests[order[first]].addr;
+        uintptr_t end = start + requests[order[first]].size;
+        size_t last = first + 1;
+
+        while (last < order.size()) {
+            const ReadRequest& next = requests[order[last]];
+            uintptr_t nextEnd = std::max(end, next.addr + next.size);
+            if (next.addr > end + ReadBatch::MaxGap || nextEnd - start > ReadBatch::MaxSpan) break;
+            if (regions && !regions->IsReadable(start, nextEnd - start)) break;
+            end = nextEnd;
+            last++;
+        }
 
-bool MemoryPhantom::WriteFloat(const std::optional<uintptr_t>& addr, float value) const {
-    return addr ? WriteFloat(*addr, value) : false;
-}
+        if (last - first == 1) {
+            ReadRequest& request = requests[order[first]];
+            request.success = InternalReadRaw(request.addr, request.dest, request.size);
+            succeeded += request.success;
+        }
+        else {
+            scratch.resize(end - start);
+            bool spanRead = InternalReadRaw(start, scratch.data(), scratch.size());
+
+            for (size_t i = first; i < last; i++) {
+                ReadRequest& request = requests[order[i]];
+                if (spanRead) {
+                    memcpy(request.dest, scratch.data() + (request.addr - start), request.size);
+                    request.success = true;
+                }
+                else {
+                    request.success = InternalReadRaw(request.addr, request.dest, request.size);
+                }
+                succeeded += request.success;
+            }
+        }
 
-bool MemoryPhantom::WriteFloat(const std::optional<uintptr_t>& addr, int offset, float value) const {
-    return addr ? WriteFloat(*addr + offset, value) : false;
+        first = last;
+    }
+
+    return succeeded;
 }
 
-bool MemoryPhantom::WriteDouble(uintptr_t addr, double value) const {
-    return InternalWrite(addr, value);
+size_t MemoryPhantom::InternalWriteBatch(WriteBatch& batch) const {
+    auto& requests = batch.requests;
+    auto& order = batch.order;
+    order.clear();
+    for (uint32_t i = 0; i < requests.size(); i++) {
+        requests[i].success = false;
+        if (requests[i].addr != 0 && requests[i].size != 0) {
+            order.push_back(i);
+        }
+    }
+    if (!IsActive() || order.empty()) return 0;
+
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return requests[a].addr < requests[b].addr;
+    });
+
+    size_t succeeded = 0;
+    size_t first = 0;
+    while (first < order.size()) {
+        uintptr_t start = requests[order[first]].addr;
+        uintptr_t end = start + requests[order[first]].size;
+        size_t last = first + 1;
+
+        while (last < order.size()) {
+            const WriteRequest& next = requests[order[last]];
+            uintptr_t nextEnd = std::max(end, next.addr + next.size);
+            if (next.addr > end || nextEnd - start > WriteBatch::MaxSpan) break;
+            end = nextEnd;
+            last++;
+        }
+
+        // Later entries win where ranges overlap, so compose and fall back in insertion order
+        std::sort(order.begin() + first, order.begin() + last);
+
+        std::vector<uint8_t>& scratch = batch.scratch;
+        scratch.resize(end - start);
+        for (size_t i = first; i < last; i++) {
+            const WriteRequest& request = requests[order[i]];
+            memcpy(scratch.data() + (request.addr - start), batch.data.data() + request.dataOffset, request.size);
+        }
+
+        if (InternalWriteRaw(start, scratch.data(), scratch.size())) {
+            for (size_t i = first; i < last; i++) requests[order[i]].success = true;
+        }
+        else {
+            for (size_t i = first; i < last; i++) {
+                WriteRequest& request = requests[order[i]];
+                request.success = InternalWriteRaw(request.addr, batch.data.data() + request.dataOffset, request.size);
+            }
+        }
+
+        if (batch.verify) {
+            std::vector<uint8_t>& readBack = batch.readBack;
+            readBack.resize(scratch.size());
+            bool spanRead = InternalReadDirect(start, readBack.data(), readBack.size());
+
+            for (size_t i = first; i < last; i++) {
+                WriteRequest& request = requests[order[i]];
+                if (!request.success) continue;
+
+                size_t at = request.addr - start;
+                if (!spanRead && !InternalReadDirect(request.addr, readBack.data() + at, request.size)) {
+                    request.success = false;
+                    continue;
+                }
+                request.success = memcmp(readBack.data() + at, scratch.data() + at, request.size) == 0;
+            }
+        }
+
+        for (size_t i = first; i < last; i++) succeeded += requests[order[i]].success;
+        first = last;
+    }
+
+    return succeeded;
 }
 
-bool MemoryPhantom::WriteDouble(uintptr_t addr, int offset, double value) const {
-    return WriteDouble(addr + offset, value);
+std::string MemoryPhantom::ReadString(uintptr_t addr, size_t length) const {
+    std::string result;
+    ReadStringInto(addr, result, length);
+    return result;
 }
 
-bool MemoryPhantom::WriteDouble(const std::optional<uintptr_t>& addr, double value) const {
-    return addr ? WriteDouble(*addr, value) : false;
+std::string MemoryPhantom::ReadString(uintptr_t addr, int offset, size_t length) const {
+    return ReadString(addr + offset, length);
 }
 
-bool MemoryPhantom::WriteDouble(const std::optional<uintptr_t>& addr, int offset, double value) const {
-    return addr ? WriteDouble(*addr + offset, value) : false;
+std::string MemoryPhantom::ReadString(const std::optional<uintptr_t>& addr, size_t length) const {
+    return addr ? ReadString(*addr, length) : "";
 }
 
-bool MemoryPhantom::WriteShort(uintptr_t addr, short value) const {
-    return InternalWrite(addr, value);
+std::string MemoryPhantom::ReadString(const std::optional<uintptr_t>& addr, int offset, size_t length) const {
+    return addr ? ReadString(*addr + offset, length) : "";
 }
 
-bool MemoryPhantom::WriteShort(uintptr_t addr, int offset, short value) const {
-    return WriteShort(addr + offset, value);
+std::wstring MemoryPhantom::ReadWString(uintptr_t addr, size_t length) const {
+    std::wstring result;
+    ReadWStringInto(addr, result, length);
+    return result;
 }
 
-bool MemoryPhantom::WriteShort(const std::optional<uintptr_t>& addr, short value) const {
-    return addr ? WriteShort(*addr, value) : false;
+std::wstring MemoryPhantom::ReadWString(uintptr_t addr, int offset, size_t length) const {
+    return ReadWString(addr + offset, length);
 }
 
-bool MemoryPhantom::WriteShort(const std::optional<uintptr_t>& addr, int offset, short value) const {
-    return addr ? WriteShort(*addr + offset, value) : false;
+std::wstring MemoryPhantom::ReadWString(const std::optional<uintptr_t>& addr, size_t length) const {
+    return addr ? ReadWString(*addr, length) : L"";
 }
 
-bool MemoryPhantom::WriteUShort(uintptr_t addr, unsigned short value) const {
-    return InternalWrite(addr, value);
+std::wstring MemoryPhantom::ReadWString(const std::optional<uintptr_t>& addr, int offset, size_t length) const {
+    return addr ? ReadWString(*addr + offset, length) : L"";
 }
 
-bool MemoryPhantom::WriteUShort(uintptr_t addr, int offset, unsigned short value) const {
-    return WriteUShort(addr + offset, value);
+std::vector<uint8_t> MemoryPhantom::ReadBytes(uintptr_t addr, size_t sz) const {
+    return InternalReadBytes(addr, sz);
 }
 
-bool MemoryPhantom::WriteUShort(const std::optional<uintptr_t>& addr, unsigned short value) const {
-    return addr ? WriteUShort(*addr, value) : false;
+std::vector<uint8_t> MemoryPhantom::ReadBytes(uintptr_t addr, int offset, size_t sz) const {
+    return InternalReadBytes(addr + offset, sz);
 }
 
-bool MemoryPhantom::WriteUShort(const std::optional<uintptr_t>& addr, int offset, unsigned short value) const {
-    return addr ? WriteUShort(*addr + offset, value) : false;
+std::vector<uint8_t> MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, size_t sz) const {
+    return addr ? ReadBytes(*addr, sz) : std::vector<uint8_t>();
 }
 
-bool MemoryPhantom::WriteUInt(uintptr_t addr, unsigned int value) const {
-    return InternalWrite(addr, value);
+std::vector<uint8_t> MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, int offset, size_t sz) const {
+    return addr ? ReadBytes(*addr + offset, sz) : std::vector<uint8_t>();
 }
 
-bool MemoryPhantom::WriteUInt(uintptr_t addr, int offset, unsigned int value) const {
-    return WriteUInt(addr + offset, value);
+bool MemoryPhantom::ReadBytes(uintptr_t addr, std::span<uint8_t> out) const {
+    return InternalReadRaw(addr, out.data(), out.size());
 }
 
-bool MemoryPhantom::WriteUInt(const std::optional<uintptr_t>& addr, unsigned int value) const {
-    return addr ? WriteUInt(*addr, value) : false;
+bool MemoryPhantom::ReadBytes(uintptr_t addr, int offset, std::span<uint8_t> out) const {
+    return ReadBytes(addr + offset, out);
 }
 
-bool MemoryPhantom::WriteUInt(const std::optional<uintptr_t>& addr, int offset, unsigned int value) const {
-    return addr ? WriteUInt(*addr + offset, value) : false;
+bool MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, std::span<uint8_t> out) const {
+    return addr ? ReadBytes(*addr, out) : false;
 }
 
-bool MemoryPhantom::WriteULong(uintptr_t addr, uint64_t value) const {
-    return InternalWrite(addr, value);
+bool MemoryPhantom::ReadStringInto(uintptr_t addr, std::string& out, size_t maxLength) const {
+    out.resize(maxLength);
+    DWORD error;
+    size_t length = InternalReadTerminated(addr, out.data(), maxLength, sizeof(char), error);
+    out.resize(length);
+    return error == ERROR_SUCCESS || length > 0;
 }
 
-bool MemoryPhantom::WriteULong(uintptr_t addr, int offset, uint64_t value) const {
-    return WriteULong(addr + offset, value);
+bool MemoryPhantom::ReadStringInto(const std::optional<uintptr_t>& addr, std::string& out, size_t maxLength) const {
+    if (addr) return ReadStringInto(*addr, out, maxLength);
+    out.clear();
+    return false;
 }
 
-bool MemoryPhantom::WriteULong(const std::optional<uintptr_t>& addr, uint64_t value) const {
-    return addr ? WriteULong(*addr, value) : false;
+bool MemoryPhantom::ReadWStringInto(uintptr_t addr, std::wstring& out, size_t maxLength) const {
+    out.resize(maxLength);
+    DWORD error;
+    size_t length = InternalReadTerminated(addr, out.data(), maxLength, sizeof(wchar_t), error);
+    out.resize(length);
+    return error == ERROR_SUCCESS || length > 0;
 }
 
-bool MemoryPhantom::WriteULong(const std::optional<uintptr_t>& addr, int offset, uint64_t value) const {
-    return addr ? WriteULong(*addr + offset, value) : false;
+bool MemoryPhantom::ReadWStringInto(const std::optional<uintptr_t>& addr, std::wstring& out, size_t maxLength) const {
+    if (addr) return ReadWStringInto(*addr, out, maxLength);
+    out.clear();
+    return false;
 }
 
-bool MemoryPhantom::WriteLong(uintptr_t addr, int64_t value) const {
-    return InternalWrite(addr, value);
+ReadResult<std::string> MemoryPhantom::TryReadString(uintptr_t addr, size_t maxLength) const {
+    ReadResult<std::string> result;
+    result.value.resize(maxLength);
+    size_t length = InternalReadTerminated(addr, result.value.data(), maxLength, sizeof(char), result.error);
+    result.value.resize(length);
+    result.bytesRead = length * sizeof(char);
+    return result;
 }
 
-bool MemoryPhantom::WriteLong(uintptr_t addr, int offset, int64_t value) const {
-    return WriteLong(addr + offset, value);
+ReadResult<std::string> MemoryPhantom::TryReadString(const std::optional<uintptr_t>& addr, size_t maxLength) const {
+    return addr ? TryReadString(*addr, maxLength) : ReadResult<std::string>{ std::string(), ERROR_INVALID_ADDRESS, 0 };
 }
 
-bool MemoryPhantom::WriteLong(const std::optional<uintptr_t>& addr, int64_t value) const {
-    return addr ? WriteLong(*addr, value) : false;
+ReadResult<std::wstring> MemoryPhantom::TryReadWString(uintptr_t addr, size_t maxLength) const {
+    ReadResult<std::wstring> result;
+    result.value.resize(maxLength);
+    size_t length = InternalReadTerminated(addr, result.value.data(), maxLength, sizeof(wchar_t), result.error);
+    result.value.resize(length);
+    result.bytesRead = length * sizeof(wchar_t);
+    return result;
 }
 
-bool MemoryPhantom::WriteLong(const std::optional<uintptr_t>& addr, int offset, int64_t value) const {
-    return addr ? WriteLong(*addr + offset, value) : false;
+ReadResult<std::wstring> MemoryPhantom::TryReadWString(const std::optional<uintptr_t>& addr, size_t maxLength) const {
+    return addr ? TryReadWString(*addr, maxLength) : ReadResult<std::wstring>{ std::wstring(), ERROR_INVALID_ADDRESS, 0 };
 }
 
-bool MemoryPhantom::WriteBool(uintptr_t addr, bool value) const {
-    return InternalWrite(addr, value);
+ReadResult<std::vector<uint8_t>> MemoryPhantom::TryReadBytes(uintptr_t addr, size_t sz) const {
+    ReadResult<std::vector<uint8_t>> result;
+    result.value.resize(sz);
+    result.bytesRead = InternalReadRaw(addr, result.value.data(), sz, result.error);
+    result.value.resize(result.bytesRead);
+    return result;
 }
 
-bool MemoryPhantom::WriteBool(uintptr_t addr, int offset, bool value) const {
-    return WriteBool(addr + offset, value);
+ReadResult<std::vector<uint8_t>> MemoryPhantom::TryReadBytes(const std::optional<uintptr_t>& addr, size_t sz) const {
+    return addr ? TryReadBytes(*addr, sz) : ReadResult<std::vector<uint8_t>>{ std::vector<uint8_t>(), ERROR_INVALID_ADDRESS, 0 };
 }
 
-bool MemoryPhantom::WriteBool(const std::optional<uintptr_t>& addr, bool value) const {
-    return addr ? WriteBool(*addr, value) : false;
+std::pmr::vector<uint8_t> MemoryPhantom::ReadBytes(uintptr_t addr, size_t sz, std::pmr::memory_resource* resource) const {
+    std::pmr::vector<uint8_t> buffer(resource ? resource : std::pmr::get_default_resource());
+    if (!IsActive() || addr == 0 || sz == 0) return buffer;
+
+    buffer.resize(sz);
+    if (!InternalReadRaw(addr, buffer.data(), sz)) buffer.clear();
+    return buffer;
 }
 
-bool MemoryPhantom::WriteBool(const std::optional<uintptr_t>& addr, int offset, bool value) const {
-    return addr ? WriteBool(*addr + offset, value) : false;
+std::pmr::vector<uint8_t> MemoryPhantom::ReadBytes(const std::optional<uintptr_t>& addr, size_t sz, std::pmr::memory_resource* resource) const {
+    return ReadBytes(addr ? *addr : 0, sz, resource);
 }
 
-bool MemoryPhantom::WriteChar(uintptr_t addr, char value) const {
-    return InternalWrite(addr, value);
+std::pmr::string MemoryPhantom::ReadString(uintptr_t addr, size_t length, std::pmr::memory_resource* resource) const {
+    std::pmr::string result(resource ? resource : std::pmr::get_default_resource());
+    result.resize(length);
+    DWORD error;
+    result.resize(InternalReadTerminated(addr, result.data(), length, sizeof(char), error));
+    return result;
 }
 
-bool MemoryPhantom::WriteChar(uintptr_t addr, int offset, char value) const {
-    return WriteChar(addr + offset, value);
+std::pmr::string MemoryPhantom::ReadString(const std::optional<uintptr_t>& addr, size_t length, std::pmr::memory_resource* resource) const {
+    return ReadString(addr ? *addr : 0, length, resource);
 }
 
-bool MemoryPhantom::WriteChar(const std::optional<uintptr_t>& addr, char value) const {
-    return addr ? WriteChar(*addr, value) : false;
+std::pmr::wstring MemoryPhantom::ReadWString(uintptr_t addr, size_t length, std::pmr::memory_resource* resource) const {
+    std::pmr::wstring result(resource ? resource : std::pmr::get_default_resource());
+    result.resize(length);
+    DWORD error;
+    result.resize(InternalReadTerminated(addr, result.data(), length, sizeof(wchar_t), error));
+    return result;
 }
 
-bool MemoryPhantom::WriteChar(const std::optional<uintptr_t>& addr, int offset, char value) const {
-    return addr ? WriteChar(*addr + offset, value) : false;
+std::pmr::wstring MemoryPhantom::ReadWString(const std::optional<uintptr_t>& addr, size_t length, std::pmr::memory_resource* resource) const {
+    return ReadWString(addr ? *addr : 0, length, resource);
 }
 
-bool MemoryPhantom::WriteByte(uintptr_t addr, uint8_t value) const {
-    return InternalWrite(addr, value);
+FrameArena& MemoryPhantom::GetFrameArena() const {
+    return LocalState().arena;
 }
 
-bool MemoryPhantom::WriteByte(uintptr_t addr, int offset, uint8_t value) const {
-    return WriteByte(addr + offset, value);
+size_t MemoryPhantom::ReadScatter(std::span<ReadRequest> requests) const {
+    thread_local std::vector<uint32_t> order;
+    thread_local std::vector<uint8_t> scratch;
+    return InternalReadScatter(requests, order, scratch);
 }
 
-bool MemoryPhantom::WriteByte(const std::optional<uintptr_t>& addr, uint8_t value) const {
-    return addr ? WriteByte(*addr, value) : false;
+size_t MemoryPhantom::Execute(ReadBatch& batch) const {
+    return InternalReadScatter(batch.requests, batch.order, batch.scratch);
 }
 
-bool MemoryPhantom::WriteByte(const std::optional<uintptr_t>& addr, int offset, uint8_t value) const {
-    return addr ? WriteByte(*addr + offset, value) : false;
+size_t MemoryPhantom::Execute(WriteBatch& batch) const {
+    return InternalWriteBatch(batch);
 }
 
 bool MemoryPhantom::WriteString(uintptr_t addr, const std::string& value) const {
-    if (!hProcess || addr == 0 || value.empty()) return false;
-
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(hProcess, reinterpret_cast<LPVOID>(addr), value.c_str(), value.length(), &bytesWritten) &&
-        bytesWritten == value.length();
+    if (!IsActive() || addr == 0 || value.empty()) return false;
+    return InternalWriteRaw(addr, value.c_str(), value.length());
 }
 
 bool MemoryPhantom::WriteString(uintptr_t addr, int offset, const std::string& value) const {
@@ -634,12 +1249,8 @@ bool MemoryPhantom::WriteString(const std::optional<uintptr_t>& addr, int offset
 }
 
 bool MemoryPhantom::WriteWString(uintptr_t addr, const std::wstring& value) const {
-    if (!hProcess || addr == 0 || value.empty()) return false;
-
-    SIZE_T bytesWritten;
-    size_t byteLength = value.length() * sizeof(wchar_t);
-    return WriteProcessMemory(hProcess, reinterpret_cast<LPVOID>(addr), value.c_str(), byteLength, &bytesWritten) &&
-        bytesWritten == byteLength;
+    if (!IsActive() || addr == 0 || value.empty()) return false;
+    return InternalWriteRaw(addr, value.c_str(), value.length() * sizeof(wchar_t));
 }
 
 bool MemoryPhantom::WriteWString(uintptr_t addr, int offset, const std::wstring& value) const {
@@ -654,44 +1265,9 @@ bool MemoryPhantom::WriteWString(const std::optional<uintptr_t>& addr, int offse
     return addr ? WriteWString(*addr + offset, value) : false;
 }
 
-bool MemoryPhantom::WriteVec3(uintptr_t addr, const Vector3& vec) const {
-    return InternalWrite(addr, vec);
-}
-
-bool MemoryPhantom::WriteVec3(uintptr_t addr, int offset, const Vector3& vec) const {
-    return WriteVec3(addr + offset, vec);
-}
-
-bool MemoryPhantom::WriteVec3(const std::optional<uintptr_t>& addr, const Vector3& vec) const {
-    return addr ? WriteVec3(*addr, vec) : false;
-}
-
-bool MemoryPhantom::WriteVec3(const std::optional<uintptr_t>& addr, int offset, const Vector3& vec) const {
-    return addr ? WriteVec3(*addr + offset, vec) : false;
-}
-
-bool MemoryPhantom::WriteMatrix(uintptr_t addr, const Mat4x4& matrix) const {
-    return InternalWrite(addr, matrix);
-}
-
-bool MemoryPhantom::WriteMatrix(uintptr_t addr, int offset, const Mat4x4& matrix) const {
-    return WriteMatrix(addr + offset, matrix);
-}
-
-bool MemoryPhantom::WriteMatrix(const std::optional<uintptr_t>& addr, const Mat4x4& matrix) const {
-    return addr ? WriteMatrix(*addr, matrix) : false;
-}
-
-bool MemoryPhantom::WriteMatrix(const std::optional<uintptr_t>& addr, int offset, const Mat4x4& matrix) const {
-    return addr ? WriteMatrix(*addr + offset, matrix) : false;
-}
-
 bool MemoryPhantom::WriteBytes(uintptr_t addr, const std::vector<uint8_t>& data) const {
-    if (!hProcess || addr == 0 || data.empty()) return false;
-
-    SIZE_T bytesWritten;
-    return WriteProcessMemory(hProcess, reinterpret_cast<LPVOID>(addr), data.data(), data.size(), &bytesWritten) &&
-        bytesWritten == data.size();
+    if (!IsActive() || addr == 0 || data.empty()) return false;
+    return InternalWriteRaw(addr, data.data(), data.size());
 }
 
 bool MemoryPhantom::WriteBytes(uintptr_t addr, int offset, const std::vector<uint8_t>& data) const {
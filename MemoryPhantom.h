@@ -8,30 +8,512 @@
 #include <optional>
 #include <cstdint>
 #include <type_traits>
+#include <span>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <string_view>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
 #include "Vectors.h"
+#include "PatternScanner.h"
+#include "RegionMap.h"
+#include "MemoryBackend.h"
+#include "ProcessIndex.h"
+#include "FrameArena.h"
+
+struct RemoteField {
+    size_t remoteOffset;
+    size_t localOffset;
+    size_t size;
+};
+
+struct RemoteSpan {
+    size_t remoteOffset;
+    size_t size;
+};
+
+template<typename T>
+struct RemoteLayout {
+    static constexpr bool defined = false;
+};
+
+// Declares where the members of a local struct live in the target, e.g.
+// PHANTOM_REMOTE_LAYOUT(Player, PHANTOM_FIELD(health, 0x100), PHANTOM_FIELD(position, 0x138))
+#define PHANTOM_FIELD(member, offset) RemoteField{ static_cast<size_t>(offset), offsetof(Self, member), sizeof(Self::member) }
+
+#define PHANTOM_REMOTE_LAYOUT_GAP(Type, gap, ...) \
+    template<> struct RemoteLayout<Type> { \
+        using Self = Type; \
+        static constexpr bool defined = true; \
+        static constexpr size_t gapThreshold = gap; \
+        static constexpr RemoteField fields[] = { __VA_ARGS__ }; \
+    }
+
+#define PHANTOM_REMOTE_LAYOUT(Type, ...) PHANTOM_REMOTE_LAYOUT_GAP(Type, 64, __VA_ARGS__)
+
+// Read<T> and Write<T> copy these as raw bytes; RemoteLayout types are gathered field by field instead
+template<typename T>
+concept RemoteValue = std::is_trivially_copyable_v<T> && !RemoteLayout<T>::defined;
+
+template<typename T>
+concept RemoteReadable = RemoteValue<T> || (RemoteLayout<T>::defined && std::is_default_constructible_v<T>);
+
+// Merges the sorted fields into spans, starting a new span when the gap exceeds the layout's threshold
+template<typename T>
+struct RemoteLayoutPlan {
+    static constexpr size_t fieldCount = std::size(RemoteLayout<T>::fields);
+
+    struct Plan {
+        std::array<RemoteSpan, fieldCount> spans{};
+        size_t spanCount = 0;
+        size_t bufferSize = 0;
+    };
+
+    static constexpr Plan Build() {
+        std::array<RemoteField, fieldCount> sorted{};
+        for (size_t i = 0; i < fieldCount; i++) sorted[i] = RemoteLayout<T>::fields[i];
+        std::sort(sorted.begin(), sorted.end(), [](const RemoteField& a, const RemoteField& b) { return a.remoteOffset < b.remoteOffset; });
+
+        Plan plan;
+        for (const RemoteField& field : sorted) {
+            if (plan.spanCount > 0) {
+                RemoteSpan& last = plan.spans[plan.spanCount - 1];
+                size_t lastEnd = last.remoteOffset + last.size;
+                if (field.remoteOffset <= lastEnd + RemoteLayout<T>::gapThreshold) {
+                    last.size = std::max(lastEnd, field.remoteOffset + field.size) - last.remoteOffset;
+                    continue;
+                }
+            }
+            plan.spans[plan.spanCount++] = { field.remoteOffset, field.size };
+        }
+        for (size_t i = 0; i < plan.spanCount; i++) plan.bufferSize += plan.spans[i].size;
+        return plan;
+    }
+
+    static constexpr Plan plan = Build();
+};
+
+template<size_t Capacity>
+class FixedString {
+public:
+    FixedString() { chars[0] = '\0'; }
+
+    const char* CStr() const { return chars; }
+    size_t Size() const { return length; }
+    bool Empty() const { return length == 0; }
+    std::string_view View() const { return std::string_view(chars, length); }
+    operator std::string_view() const { return View(); }
 
-class MemoryPhantom {
 private:
-    HANDLE hProcess;
-    DWORD processId;
+    friend class MemoryPhantom;
+
+    char chars[Capacity + 1];
+    size_t length = 0;
+};
+
+// Value plus status of one read. error is ERROR_SUCCESS or the GetLastError() code of the failing call
+// (ERROR_INVALID_HANDLE when detached, ERROR_INVALID_ADDRESS for a null address, ERROR_NOACCESS when the
+// region map rules the range out). bytesRead counts the leading bytes that arrived; strings and byte
+// vectors keep that prefix in value, other types are value-initialized whenever the read fails.
+template<typename T>
+struct ReadResult {
+    T value{};
+    DWORD error = ERROR_SUCCESS;
+    size_t bytesRead = 0;
+
+    bool Ok() const { return error == ERROR_SUCCESS; }
+    bool Partial() const { return !Ok() && bytesRead > 0; }
+    explicit operator bool() const { return Ok(); }
+
+    const T& operator*() const { return value; }
+    const T* operator->() const { return &value; }
+    T ValueOr(T fallback) const { return Ok() ? value : fallback; }
+};
+
+struct ReadRequest {
+    uintptr_t addr;
+    size_t size;
+    void* dest;
+    bool success;
+};
+
+class ReadBatch {
+public:
+    static constexpr size_t MaxGap = 256;
+    static constexpr size_t MaxSpan = 1024 * 1024;
+
+    size_t AddBytes(uintptr_t addr, void* dest, size_t size) {
+        requests.push_back({ addr, size, dest, false });
+        return requests.size() - 1;
+    }
+
+    template<typename T>
+    size_t Add(uintptr_t addr, T& out) {
+        static_assert(std::is_trivially_copyable_v<T>, "ReadBatch slots must be trivially copyable");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout must be read with Read<T>");
+        return AddBytes(addr, &out, sizeof(T));
+    }
+
+    template<typename T>
+    size_t Add(uintptr_t addr, int offset, T& out) {
+        return Add<T>(addr + offset, out);
+    }
+
+    template<typename T>
+    size_t Add(const std::optional<uintptr_t>& addr, T& out) {
+        return Add<T>(addr ? *addr : 0, out);
+    }
+
+    template<typename T>
+    size_t Add(const std::optional<uintptr_t>& addr, int offset, T& out) {
+        return Add<T>(addr ? *addr + offset : 0, out);
+    }
+
+    bool Succeeded(size_t index) const { return index < requests.size() && requests[index].success; }
+    size_t Size() const { return requests.size(); }
+    void Clear() { requests.clear(); }
+
+    std::span<ReadRequest> Requests() { return requests; }
+    std::span<const ReadRequest> Requests() const { return requests; }
+
+private:
+    friend class MemoryPhantom;
+
+    std::vector<ReadRequest> requests;
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> scratch;
+};
+
+struct WriteRequest {
+    uintptr_t addr;
+    size_t size;
+    size_t dataOffset;
+    bool success;
+};
+
+class WriteBatch {
+public:
+    static constexpr size_t MaxSpan = 1024 * 1024;
+
+    size_t AddBytes(uintptr_t addr, const void* src, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(src);
+        requests.push_back({ addr, size, data.size(), false });
+        data.insert(data.end(), bytes, bytes + size);
+        return requests.size() - 1;
+    }
+
+    template<typename T>
+    size_t Add(uintptr_t addr, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "WriteBatch values must be trivially copyable");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout cannot be written as a block");
+        return AddBytes(addr, &value, sizeof(T));
+    }
+
+    template<typename T>
+    size_t Add(uintptr_t addr, int offset, const T& value) {
+        return Add<T>(addr + offset, value);
+    }
+
+    template<typename T>
+    size_t Add(const std::optional<uintptr_t>& addr, const T& value) {
+        return Add<T>(addr ? *addr : 0, value);
+    }
 
     template<typename T>
-    bool InternalRead(uintptr_t addr, T& value) const {
-        if (!hProcess || addr == 0) return false;
-        SIZE_T bytesRead;
-        return ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(addr), &value, sizeof(T), &bytesRead) &&
-            bytesRead == sizeof(T);
+    size_t Add(const std::optional<uintptr_t>& addr, int offset, const T& value) {
+        return Add<T>(addr ? *addr + offset : 0, value);
     }
 
+    void SetVerify(bool enabled) { verify = enabled; }
+    bool IsVerifyEnabled() const { return verify; }
+
+    bool Succeeded(size_t index) const { return index < requests.size() && requests[index].success; }
+    std::vector<size_t> Failures() const {
+        std::vector<size_t> failed;
+        for (size_t i = 0; i < requests.size(); i++) {
+            if (!requests[i].success) failed.push_back(i);
+        }
+        return failed;
+    }
+
+    size_t Size() const { return requests.size(); }
+    void Clear() { requests.clear(); data.clear(); }
+
+    std::span<const WriteRequest> Requests() const { return requests; }
+
+private:
+    friend class MemoryPhantom;
+
+    std::vector<WriteRequest> requests;
+    std::vector<uint8_t> data;
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> scratch;
+    std::vector<uint8_t> readBack;
+    bool verify = false;
+};
+
+// Rights sets for common uses, weakest first. ReadOnly is enough for reads and Toolhelp module lookups;
+// Scan adds PROCESS_QUERY_INFORMATION for VirtualQueryEx, so region maps, QueryRegions and module scans work;
+// ReadWrite adds what WriteProcessMemory needs.
+enum class AccessProfile : uint8_t {
+    ReadOnly,
+    Scan,
+    ReadWrite,
+    Full
+};
+
+constexpr DWORD ProfileRights(AccessProfile profile) {
+    constexpr DWORD readOnly = PROCESS_VM_READ | PROCESS_QUERY_LIMITED_INFORMATION;
+    constexpr DWORD scan = readOnly | PROCESS_QUERY_INFORMATION;
+    switch (profile) {
+    case AccessProfile::ReadOnly: return readOnly;
+    case AccessProfile::Scan: return scan;
+    case AccessProfile::ReadWrite: return scan | PROCESS_VM_WRITE | PROCESS_VM_OPERATION;
+    default: return PROCESS_ALL_ACCESS;
+    }
+}
+
+// Strongest profile whose rights are all contained in rights
+constexpr std::optional<AccessProfile> ProfileFor(DWORD rights) {
+    for (int level = static_cast<int>(AccessProfile::Full); level >= 0; level--) {
+        DWORD needed = ProfileRights(static_cast<AccessProfile>(level));
+        if ((rights & needed) == needed) return static_cast<AccessProfile>(level);
+    }
+    return std::nullopt;
+}
+
+// Either exact rights, or a profile that falls back to weaker profiles down to minimum when the
+// open is denied. Converts from DWORD, so existing accessRights arguments keep working.
+struct AccessRequest {
+    DWORD rights = 0;
+    AccessProfile preferred = AccessProfile::Full;
+    AccessProfile minimum = AccessProfile::Full;
+    bool profile = false;
+
+    AccessRequest(DWORD rights) : rights(rights) {}
+    AccessRequest(AccessProfile preferred, AccessProfile minimum = AccessProfile::ReadOnly)
+        : preferred(preferred), minimum(std::min(minimum, preferred)), profile(true) {}
+
+    bool IsProfile() const { return profile; }
+};
+
+class MemoryPhantom {
+public:
+    static constexpr size_t PageSize = 0x1000;
+    static constexpr size_t CacheMaxRead = 16 * PageSize;
+
+    struct CacheStats {
+        uint64_t hits;
+        uint64_t misses;
+        size_t pages;
+    };
+
+    struct ThreadStats {
+        std::thread::id thread;
+        bool alive;
+        uint64_t reads;
+        uint64_t bytesRead;
+        uint64_t writes;
+        uint64_t bytesWritten;
+        uint64_t cacheHits;
+        uint64_t cacheMisses;
+        size_t pages;
+        uint64_t skippedReads;
+    };
+
+    // Populated only when built with PHANTOM_STATS; otherwise the hot paths carry no timing or error bookkeeping
+#if defined(PHANTOM_STATS)
+    static constexpr bool StatsEnabled = true;
+#else
+    static constexpr bool StatsEnabled = false;
+#endif
+
+    struct LatencyHistogram {
+        // Bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds; the last bucket is open-ended
+        static constexpr size_t Buckets = 32;
+
+        uint64_t counts[Buckets];
+        uint64_t calls;
+        uint64_t totalNs;
+        uint64_t maxNs;
+
+        double MeanNs() const { return calls ? static_cast<double>(totalNs) / calls : 0.0; }
+        // Upper bound of the bucket that holds the given fraction (0.5, 0.99, ...) of calls
+        uint64_t PercentileNs(double fraction) const;
+    };
+
+    struct ErrorCount {
+        DWORD code;
+        uint64_t count;
+    };
+
+    struct OperationStats {
+        uint64_t reads;
+        uint64_t readFailures;
+        uint64_t bytesRead;
+        uint64_t writes;
+        uint64_t writeFailures;
+        uint64_t bytesWritten;
+        LatencyHistogram readLatency;
+        LatencyHistogram writeLatency;
+        std::vector<ErrorCount> errors;   // GetLastError codes of failed calls, most frequent first
+        uint64_t otherErrors;             // Failures whose code did not fit in a thread's error table
+    };
+
+    using ModuleInfo = ProcessModule;
+
+    static constexpr std::chrono::milliseconds ModuleRefreshInterval = std::chrono::milliseconds(100);
+    static constexpr std::chrono::milliseconds RegionRefreshInterval = std::chrono::milliseconds(1000);
+    // Expired unreadable ranges re-queried per ReadScatter/Execute; later ones are skipped until the next batch
+    static constexpr size_t BatchRegionRefreshes = 4;
+
+private:
+    struct ModuleNameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+    struct CachedPage {
+        uint64_t epoch;
+        uint64_t written;
+        std::chrono::steady_clock::time_point fetched;
+        DWORD error;
+        uint8_t data[PageSize];
+    };
+
+    // Owned by one thread; only the counters are read from other threads
+#if defined(PHANTOM_STATS)
+    static constexpr size_t ErrorSlots = 16;
+
+    // Written only by the owning thread; other threads read them for snapshots
+    struct OperationCounters {
+        std::atomic<uint64_t> failures{ 0 };
+        std::atomic<uint64_t> totalNs{ 0 };
+        std::atomic<uint64_t> maxNs{ 0 };
+        std::atomic<uint64_t> buckets[LatencyHistogram::Buckets]{};
+    };
+#endif
+
+    struct ThreadState {
+        std::thread::id thread;
+        std::atomic<bool> alive{ true };
+        uint64_t generation = 0;
+        std::unordered_map<uintptr_t, std::unique_ptr<CachedPage>> pages;
+        std::atomic<size_t> pageCount{ 0 };
+        std::atomic<uint64_t> reads{ 0 };
+        std::atomic<uint64_t> bytesRead{ 0 };
+        std::atomic<uint64_t> writes{ 0 };
+        std::atomic<uint64_t> bytesWritten{ 0 };
+        std::atomic<uint64_t> cacheHits{ 0 };
+        std::atomic<uint64_t> cacheMisses{ 0 };
+        std::atomic<uint64_t> skippedReads{ 0 };
+        std::shared_ptr<const RegionMap> regions;
+        uint64_t regionVersion = 0;
+        size_t regionRefreshBudget = SIZE_MAX;
+        FrameArena arena;
+#if defined(PHANTOM_STATS)
+        OperationCounters readOps;
+        OperationCounters writeOps;
+        std::atomic<DWORD> errorCodes[ErrorSlots]{};
+        std::atomic<uint64_t> errorCounts[ErrorSlots]{};
+        std::atomic<uint64_t> otherErrors{ 0 };
+#endif
+    };
+
+    static constexpr size_t WriteVersionSlots = 1024;
+
+    struct ThreadRegistry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadState>> states;
+        // Bumped by every write to a page that hashes to the slot; each cache refetches pages fetched under an older value
+        std::atomic<uint64_t> writeVersions[WriteVersionSlots]{};
+    };
+
+    using ModuleTable = std::unordered_map<std::string, ModuleInfo, ModuleNameHash, std::equal_to<>>;
+
+    HANDLE hProcess;
+    DWORD processId;
+    DWORD grantedAccess;
+    std::shared_ptr<const MemoryBackend> backend;
+
+    bool cacheEnabled;
+    std::chrono::milliseconds cacheTtl;
+    mutable std::atomic<uint64_t> cacheEpoch;
+    mutable std::atomic<uint64_t> cacheGeneration;
+    std::shared_ptr<ThreadRegistry> threads;
+
+    bool moduleAutoRefresh;
+    mutable std::atomic<std::shared_ptr<const ModuleTable>> modules;
+    mutable std::atomic<std::chrono::steady_clock::time_point> modulesRefreshed;
+
+    bool regionMapEnabled;
+    std::chrono::milliseconds regionTtl;
+    mutable std::mutex regionMutex;
+    mutable std::shared_ptr<const RegionMap> regionMap;
+    mutable std::atomic<uint64_t> regionVersion;
+
+    // Returns how many bytes of the layout's spans were read; value is only filled in when all of them were
     template<typename T>
-    bool InternalWrite(uintptr_t addr, const T& value) const {
-        if (!hProcess || addr == 0) return false;
-        SIZE_T bytesWritten;
-        return WriteProcessMemory(hProcess, reinterpret_cast<LPVOID>(addr), &value, sizeof(T), &bytesWritten) &&
-            bytesWritten == sizeof(T);
+    size_t InternalReadLayout(uintptr_t addr, T& value, DWORD& error) const {
+        using Plan = RemoteLayoutPlan<T>;
+        std::array<uint8_t, Plan::plan.bufferSize> buffer;
+
+        size_t position = 0;
+        for (size_t i = 0; i < Plan::plan.spanCount; i++) {
+            const RemoteSpan& span = Plan::plan.spans[i];
+            size_t read = InternalReadRaw(addr + span.remoteOffset, buffer.data() + position, span.size, error);
+            if (read != span.size) return position + read;
+            position += span.size;
+        }
+
+        for (const RemoteField& field : RemoteLayout<T>::fields) {
+            position = 0;
+            size_t i = 0;
+            while (field.remoteOffset >= Plan::plan.spans[i].remoteOffset + Plan::plan.spans[i].size) {
+                position += Plan::plan.spans[i].size;
+                i++;
+            }
+            memcpy(reinterpret_cast<uint8_t*>(&value) + field.localOffset,
+                buffer.data() + position + (field.remoteOffset - Plan::plan.spans[i].remoteOffset), field.size);
+        }
+        return Plan::plan.bufferSize;
     }
 
+    friend class MemoryScanner;
+
     std::vector<uint8_t> InternalReadBytes(uintptr_t addr, size_t sz) const;
+    size_t InternalReadTerminated(uintptr_t addr, void* buffer, size_t maxUnits, size_t unitSize, DWORD& error) const;
+    bool InternalReadDirect(uintptr_t addr, void* buffer, size_t sz) const;
+    size_t InternalReadDirect(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const;
+    bool InternalReadRaw(uintptr_t addr, void* buffer, size_t sz) const;
+    size_t InternalReadRaw(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const;
+    bool InternalWriteRaw(uintptr_t addr, const void* buffer, size_t sz) const;
+    size_t InternalReadCached(uintptr_t addr, void* buffer, size_t sz, DWORD& error) const;
+    const CachedPage* FetchPage(ThreadState& state, uintptr_t page) const;
+    ThreadState& LocalState() const;
+    const RegionMap* LocalRegions(ThreadState& state) const;
+    bool RegionAllows(ThreadState& state, uintptr_t addr, size_t sz) const;
+    void PublishRegionMap(std::shared_ptr<const RegionMap> map) const;
+    std::atomic<uint64_t>& WriteVersion(uintptr_t page) const { return threads->writeVersions[(page / PageSize) % WriteVersionSlots]; }
+    void PublishWrite(uintptr_t addr, size_t sz) const;
+#if defined(PHANTOM_STATS)
+    static void RecordOperation(ThreadState& state, OperationCounters& counters, std::chrono::steady_clock::time_point started, DWORD error);
+#endif
+    size_t InternalReadScatter(std::span<ReadRequest> requests, std::vector<uint32_t>& order, std::vector<uint8_t>& scratch) const;
+    size_t InternalWriteBatch(WriteBatch& batch) const;
+    template<typename Results>
+    bool InternalPatternScan(uintptr_t start, size_t size, uintptr_t boundEnd, const BytePattern& pattern, size_t chunkSize,
+        Results& results, bool firstOnly, std::pmr::memory_resource* resource) const;
+    bool SnapshotModules(std::vector<ModuleInfo>& found) const;
+    bool EnumerateModules(std::vector<ModuleInfo>& found) const;
+    std::shared_ptr<const ModuleInfo> LookupModule(const char* moduleName) const;
+    static std::optional<MemoryPhantom> AttachFirst(std::span<const DWORD> pids, AccessRequest access);
 
 public:
     struct Mat4x4 {
@@ -40,7 +522,7 @@ public:
     };
 
     MemoryPhantom();
-    MemoryPhantom(DWORD pid, DWORD accessRights = PROCESS_ALL_ACCESS);
+    MemoryPhantom(DWORD pid, AccessRequest access = PROCESS_ALL_ACCESS);
     ~MemoryPhantom();
 
     MemoryPhantom(const MemoryPhantom&) = delete;
@@ -49,70 +531,125 @@ public:
     MemoryPhantom(MemoryPhantom&& other) noexcept;
     MemoryPhantom& operator=(MemoryPhantom&& other) noexcept;
 
-    bool Attach(DWORD pid, DWORD accessRights = PROCESS_ALL_ACCESS);
+    // A profile request costs one OpenProcess per profile tried; only ERROR_ACCESS_DENIED moves on to a weaker one
+    bool Attach(DWORD pid, AccessRequest access = PROCESS_ALL_ACCESS);
+    bool Attach(DWORD pid, std::shared_ptr<const MemoryBackend> memoryBackend, AccessRequest access = PROCESS_ALL_ACCESS);
+    bool Attach(std::shared_ptr<const MemoryBackend> memoryBackend);
     void Detach();
     bool IsActive() const;
     DWORD GetPID() const;
     HANDLE GetHandle() const;
+    std::shared_ptr<const MemoryBackend> GetBackend() const;
 
-    static std::optional<MemoryPhantom> CreateFromName(const char* processName, DWORD accessRights = PROCESS_ALL_ACCESS);
+    // Rights the handle was opened with; 0 when detached or attached to a backend only
+    DWORD GetGrantedAccess() const;
+    bool HasAccess(DWORD rights) const;
+    std::optional<AccessProfile> GetAccessProfile() const;
 
-    std::optional<uintptr_t> FindModuleBase(const char* moduleName) const;
+    // Zero-copy view of target memory; empty unless the backend maps the whole range
+    std::span<const uint8_t> View(uintptr_t addr, size_t size) const;
+
+    static std::optional<MemoryPhantom> CreateFromName(const char* processName, AccessRequest access = PROCESS_ALL_ACCESS);
+
+    // Attach to the first match in the index that can be opened; the index is not refreshed here
+    static std::optional<MemoryPhantom> CreateFromName(const ProcessIndex& index, std::wstring_view processName,
+        AccessRequest access = PROCESS_ALL_ACCESS);
+    static std::optional<MemoryPhantom> CreateFromModule(const ProcessIndex& index, std::wstring_view moduleName,
+        std::wstring_view processName = {}, AccessRequest access = PROCESS_ALL_ACCESS);
+    static std::optional<MemoryPhantom> CreateFromWindowTitle(const ProcessIndex& index, std::wstring_view title,
+        AccessRequest access = PROCESS_ALL_ACCESS);
 
-    int ReadInt(uintptr_t addr) const;
-    int ReadInt(uintptr_t addr, int offset) const;
-    int ReadInt(const std::optional<uintptr_t>& addr) const;
-    int ReadInt(const std::optional<uintptr_t>& addr, int offset) const;
-
-    float ReadFloat(uintptr_t addr) const;
-    float ReadFloat(uintptr_t addr, int offset) const;
-    float ReadFloat(const std::optional<uintptr_t>& addr) const;
-    float ReadFloat(const std::optional<uintptr_t>& addr, int offset) const;
-
-    double ReadDouble(uintptr_t addr) const;
-    double ReadDouble(uintptr_t addr, int offset) const;
-    double ReadDouble(const std::optional<uintptr_t>& addr) const;
-    double ReadDouble(const std::optional<uintptr_t>& addr, int offset) const;
-
-    short ReadShort(uintptr_t addr) const;
-    short ReadShort(uintptr_t addr, int offset) const;
-    short ReadShort(const std::optional<uintptr_t>& addr) const;
-    short ReadShort(const std::optional<uintptr_t>& addr, int offset) const;
-
-    unsigned short ReadUShort(uintptr_t addr) const;
-    unsigned short ReadUShort(uintptr_t addr, int offset) const;
-    unsigned short ReadUShort(const std::optional<uintptr_t>& addr) const;
-    unsigned short ReadUShort(const std::optional<uintptr_t>& addr, int offset) const;
-
-    unsigned int ReadUInt(uintptr_t addr) const;
-    unsigned int ReadUInt(uintptr_t addr, int offset) const;
-    unsigned int ReadUInt(const std::optional<uintptr_t>& addr) const;
-    unsigned int ReadUInt(const std::optional<uintptr_t>& addr, int offset) const;
-
-    uint64_t ReadULong(uintptr_t addr) const;
-    uint64_t ReadULong(uintptr_t addr, int offset) const;
-    uint64_t ReadULong(const std::optional<uintptr_t>& addr) const;
-    uint64_t ReadULong(const std::optional<uintptr_t>& addr, int offset) const;
-
-    int64_t ReadLong(uintptr_t addr) const;
-    int64_t ReadLong(uintptr_t addr, int offset) const;
-    int64_t ReadLong(const std::optional<uintptr_t>& addr) const;
-    int64_t ReadLong(const std::optional<uintptr_t>& addr, int offset) const;
-
-    bool ReadBool(uintptr_t addr) const;
-    bool ReadBool(uintptr_t addr, int offset) const;
-    bool ReadBool(const std::optional<uintptr_t>& addr) const;
-    bool ReadBool(const std::optional<uintptr_t>& addr, int offset) const;
-
-    char ReadChar(uintptr_t addr) const;
-    char ReadChar(uintptr_t addr, int offset) const;
-    char ReadChar(const std::optional<uintptr_t>& addr) const;
-    char ReadChar(const std::optional<uintptr_t>& addr, int offset) const;
-
-    uint8_t ReadByte(uintptr_t addr) const;
-    uint8_t ReadByte(uintptr_t addr, int offset) const;
-    uint8_t ReadByte(const std::optional<uintptr_t>& addr) const;
-    uint8_t ReadByte(const std::optional<uintptr_t>& addr, int offset) const;
+    std::optional<uintptr_t> FindModuleBase(const char* moduleName) const;
+    std::optional<ModuleInfo> FindModule(const char* moduleName) const;
+    std::vector<ModuleInfo> GetModules() const;
+    bool RefreshModules() const;
+    void SetModuleAutoRefresh(bool enabled);
+
+    std::vector<MemoryRegion> QueryRegions(uintptr_t start = 0, uintptr_t end = UINTPTR_MAX, bool readableOnly = true) const;
+
+    bool EnableRegionMap(std::chrono::milliseconds ttl = RegionRefreshInterval);
+    void DisableRegionMap();
+    bool IsRegionMapEnabled() const;
+    bool RefreshRegionMap() const;
+    bool RefreshRegionMap(uintptr_t start, size_t size) const;
+    std::shared_ptr<const RegionMap> GetRegionMap() const;
+
+    static constexpr size_t PatternChunkSize = 4 * 1024 * 1024;
+
+    std::optional<uintptr_t> PatternScan(const char* moduleName, const char* pattern) const;
+    std::optional<uintptr_t> PatternScan(uintptr_t start, size_t size, const char* pattern) const;
+    std::optional<uintptr_t> PatternScan(uintptr_t start, size_t size, const BytePattern& pattern) const;
+    std::vector<uintptr_t> PatternScanAll(const char* moduleName, const char* pattern) const;
+    std::vector<uintptr_t> PatternScanAll(uintptr_t start, size_t size, const BytePattern& pattern) const;
+    // Results and chunk buffer both come from resource
+    std::pmr::vector<uintptr_t> PatternScanAll(uintptr_t start, size_t size, const BytePattern& pattern, std::pmr::memory_resource* resource) const;
+
+    void EnableReadCache(std::chrono::milliseconds ttl = std::chrono::milliseconds(0));
+    void DisableReadCache();
+    bool IsReadCacheEnabled() const;
+    void BeginFrame() const;
+    uint64_t GetEpoch() const;
+    void InvalidateCache() const;
+    CacheStats GetCacheStats() const;
+    void ResetCacheStats();
+    std::vector<ThreadStats> GetThreadStats() const;
+    OperationStats GetOperationStats() const;
+    void ResetOperationStats();
+
+    int ReadInt(uintptr_t addr) const { return Read<int>(addr); }
+    int ReadInt(uintptr_t addr, int offset) const { return Read<int>(addr, offset); }
+    int ReadInt(const std::optional<uintptr_t>& addr) const { return Read<int>(addr); }
+    int ReadInt(const std::optional<uintptr_t>& addr, int offset) const { return Read<int>(addr, offset); }
+
+    float ReadFloat(uintptr_t addr) const { return Read<float>(addr); }
+    float ReadFloat(uintptr_t addr, int offset) const { return Read<float>(addr, offset); }
+    float ReadFloat(const std::optional<uintptr_t>& addr) const { return Read<float>(addr); }
+    float ReadFloat(const std::optional<uintptr_t>& addr, int offset) const { return Read<float>(addr, offset); }
+
+    double ReadDouble(uintptr_t addr) const { return Read<double>(addr); }
+    double ReadDouble(uintptr_t addr, int offset) const { return Read<double>(addr, offset); }
+    double ReadDouble(const std::optional<uintptr_t>& addr) const { return Read<double>(addr); }
+    double ReadDouble(const std::optional<uintptr_t>& addr, int offset) const { return Read<double>(addr, offset); }
+
+    short ReadShort(uintptr_t addr) const { return Read<short>(addr); }
+    short ReadShort(uintptr_t addr, int offset) const { return Read<short>(addr, offset); }
+    short ReadShort(const std::optional<uintptr_t>& addr) const { return Read<short>(addr); }
+    short ReadShort(const std::optional<uintptr_t>& addr, int offset) const { return Read<short>(addr, offset); }
+
+    unsigned short ReadUShort(uintptr_t addr) const { return Read<unsigned short>(addr); }
+    unsigned short ReadUShort(uintptr_t addr, int offset) const { return Read<unsigned short>(addr, offset); }
+    unsigned short ReadUShort(const std::optional<uintptr_t>& addr) const { return Read<unsigned short>(addr); }
+    unsigned short ReadUShort(const std::optional<uintptr_t>& addr, int offset) const { return Read<unsigned short>(addr, offset); }
+
+    unsigned int ReadUInt(uintptr_t addr) const { return Read<unsigned int>(addr); }
+    unsigned int ReadUInt(uintptr_t addr, int offset) const { return Read<unsigned int>(addr, offset); }
+    unsigned int ReadUInt(const std::optional<uintptr_t>& addr) const { return Read<unsigned int>(addr); }
+    unsigned int ReadUInt(const std::optional<uintptr_t>& addr, int offset) const { return Read<unsigned int>(addr, offset); }
+
+    uint64_t ReadULong(uintptr_t addr) const { return Read<uint64_t>(addr); }
+    uint64_t ReadULong(uintptr_t addr, int offset) const { return Read<uint64_t>(addr, offset); }
+    uint64_t ReadULong(const std::optional<uintptr_t>& addr) const { return Read<uint64_t>(addr); }
+    uint64_t ReadULong(const std::optional<uintptr_t>& addr, int offset) const { return Read<uint64_t>(addr, offset); }
+
+    int64_t ReadLong(uintptr_t addr) const { return Read<int64_t>(addr); }
+    int64_t ReadLong(uintptr_t addr, int offset) const { return Read<int64_t>(addr, offset); }
+    int64_t ReadLong(const std::optional<uintptr_t>& addr) const { return Read<int64_t>(addr); }
+    int64_t ReadLong(const std::optional<uintptr_t>& addr, int offset) const { return Read<int64_t>(addr, offset); }
+
+    bool ReadBool(uintptr_t addr) const { return Read<bool>(addr); }
+    bool ReadBool(uintptr_t addr, int offset) const { return Read<bool>(addr, offset); }
+    bool ReadBool(const std::optional<uintptr_t>& addr) const { return Read<bool>(addr); }
+    bool ReadBool(const std::optional<uintptr_t>& addr, int offset) const { return Read<bool>(addr, offset); }
+
+    char ReadChar(uintptr_t addr) const { return Read<char>(addr); }
+    char ReadChar(uintptr_t addr, int offset) const { return Read<char>(addr, offset); }
+    char ReadChar(const std::optional<uintptr_t>& addr) const { return Read<char>(addr); }
+    char ReadChar(const std::optional<uintptr_t>& addr, int offset) const { return Read<char>(addr, offset); }
+
+    uint8_t ReadByte(uintptr_t addr) const { return Read<uint8_t>(addr); }
+    uint8_t ReadByte(uintptr_t addr, int offset) const { return Read<uint8_t>(addr, offset); }
+    uint8_t ReadByte(const std::optional<uintptr_t>& addr) const { return Read<uint8_t>(addr); }
+    uint8_t ReadByte(const std::optional<uintptr_t>& addr, int offset) const { return Read<uint8_t>(addr, offset); }
 
     std::string ReadString(uintptr_t addr, size_t length) const;
     std::string ReadString(uintptr_t addr, int offset, size_t length) const;
@@ -124,80 +661,131 @@ public:
     std::wstring ReadWString(const std::optional<uintptr_t>& addr, size_t length) const;
     std::wstring ReadWString(const std::optional<uintptr_t>& addr, int offset, size_t length) const;
 
-    Vector3 ReadVec3(uintptr_t addr) const;
-    Vector3 ReadVec3(uintptr_t addr, int offset) const;
-    Vector3 ReadVec3(const std::optional<uintptr_t>& addr) const;
-    Vector3 ReadVec3(const std::optional<uintptr_t>& addr, int offset) const;
+    Vector3 ReadVec3(uintptr_t addr) const { return Read<Vector3>(addr); }
+    Vector3 ReadVec3(uintptr_t addr, int offset) const { return Read<Vector3>(addr, offset); }
+    Vector3 ReadVec3(const std::optional<uintptr_t>& addr) const { return Read<Vector3>(addr); }
+    Vector3 ReadVec3(const std::optional<uintptr_t>& addr, int offset) const { return Read<Vector3>(addr, offset); }
 
-    std::optional<Mat4x4> ReadMatrix(uintptr_t addr) const;
-    std::optional<Mat4x4> ReadMatrix(uintptr_t addr, int offset) const;
-    std::optional<Mat4x4> ReadMatrix(const std::optional<uintptr_t>& addr) const;
-    std::optional<Mat4x4> ReadMatrix(const std::optional<uintptr_t>& addr, int offset) const;
+    std::optional<Mat4x4> ReadMatrix(uintptr_t addr) const {
+        Mat4x4 matrix;
+        if (InternalReadRaw(addr, &matrix, sizeof(matrix))) return matrix;
+        return std::nullopt;
+    }
+    std::optional<Mat4x4> ReadMatrix(uintptr_t addr, int offset) const { return ReadMatrix(addr + offset); }
+    std::optional<Mat4x4> ReadMatrix(const std::optional<uintptr_t>& addr) const { return addr ? ReadMatrix(*addr) : std::nullopt; }
+    std::optional<Mat4x4> ReadMatrix(const std::optional<uintptr_t>& addr, int offset) const { return addr ? ReadMatrix(*addr + offset) : std::nullopt; }
 
-    uintptr_t ReadPtr(uintptr_t addr) const;
-    uintptr_t ReadPtr(uintptr_t addr, int offset) const;
-    uintptr_t ReadPtr(const std::optional<uintptr_t>& addr) const;
-    uintptr_t ReadPtr(const std::optional<uintptr_t>& addr, int offset) const;
+    uintptr_t ReadPtr(uintptr_t addr) const { return Read<uintptr_t>(addr); }
+    uintptr_t ReadPtr(uintptr_t addr, int offset) const { return Read<uintptr_t>(addr, offset); }
+    uintptr_t ReadPtr(const std::optional<uintptr_t>& addr) const { return Read<uintptr_t>(addr); }
+    uintptr_t ReadPtr(const std::optional<uintptr_t>& addr, int offset) const { return Read<uintptr_t>(addr, offset); }
 
     std::vector<uint8_t> ReadBytes(uintptr_t addr, size_t sz) const;
     std::vector<uint8_t> ReadBytes(uintptr_t addr, int offset, size_t sz) const;
     std::vector<uint8_t> ReadBytes(const std::optional<uintptr_t>& addr, size_t sz) const;
     std::vector<uint8_t> ReadBytes(const std::optional<uintptr_t>& addr, int offset, size_t sz) const;
 
-    bool WriteInt(uintptr_t addr, int value) const;
-    bool WriteInt(uintptr_t addr, int offset, int value) const;
-    bool WriteInt(const std::optional<uintptr_t>& addr, int value) const;
-    bool WriteInt(const std::optional<uintptr_t>& addr, int offset, int value) const;
-
-    bool WriteFloat(uintptr_t addr, float value) const;
-    bool WriteFloat(uintptr_t addr, int offset, float value) const;
-    bool WriteFloat(const std::optional<uintptr_t>& addr, float value) const;
-    bool WriteFloat(const std::optional<uintptr_t>& addr, int offset, float value) const;
-
-    bool WriteDouble(uintptr_t addr, double value) const;
-    bool WriteDouble(uintptr_t addr, int offset, double value) const;
-    bool WriteDouble(const std::optional<uintptr_t>& addr, double value) const;
-    bool WriteDouble(const std::optional<uintptr_t>& addr, int offset, double value) const;
-
-    bool WriteShort(uintptr_t addr, short value) const;
-    bool WriteShort(uintptr_t addr, int offset, short value) const;
-    bool WriteShort(const std::optional<uintptr_t>& addr, short value) const;
-    bool WriteShort(const std::optional<uintptr_t>& addr, int offset, short value) const;
-
-    bool WriteUShort(uintptr_t addr, unsigned short value) const;
-    bool WriteUShort(uintptr_t addr, int offset, unsigned short value) const;
-    bool WriteUShort(const std::optional<uintptr_t>& addr, unsigned short value) const;
-    bool WriteUShort(const std::optional<uintptr_t>& addr, int offset, unsigned short value) const;
-
-    bool WriteUInt(uintptr_t addr, unsigned int value) const;
-    bool WriteUInt(uintptr_t addr, int offset, unsigned int value) const;
-    bool WriteUInt(const std::optional<uintptr_t>& addr, unsigned int value) const;
-    bool WriteUInt(const std::optional<uintptr_t>& addr, int offset, unsigned int value) const;
-
-    bool WriteULong(uintptr_t addr, uint64_t value) const;
-    bool WriteULong(uintptr_t addr, int offset, uint64_t value) const;
-    bool WriteULong(const std::optional<uintptr_t>& addr, uint64_t value) const;
-    bool WriteULong(const std::optional<uintptr_t>& addr, int offset, uint64_t value) const;
-
-    bool WriteLong(uintptr_t addr, int64_t value) const;
-    bool WriteLong(uintptr_t addr, int offset, int64_t value) const;
-    bool WriteLong(const std::optional<uintptr_t>& addr, int64_t value) const;
-    bool WriteLong(const std::optional<uintptr_t>& addr, int offset, int64_t value) const;
-
-    bool WriteBool(uintptr_t addr, bool value) const;
-    bool WriteBool(uintptr_t addr, int offset, bool value) const;
-    bool WriteBool(const std::optional<uintptr_t>& addr, bool value) const;
-    bool WriteBool(const std::optional<uintptr_t>& addr, int offset, bool value) const;
-
-    bool WriteChar(uintptr_t addr, char value) const;
-    bool WriteChar(uintptr_t addr, int offset, char value) const;
-    bool WriteChar(const std::optional<uintptr_t>& addr, char value) const;
-    bool WriteChar(const std::optional<uintptr_t>& addr, int offset, char value) const;
-
-    bool WriteByte(uintptr_t addr, uint8_t value) const;
-    bool WriteByte(uintptr_t addr, int offset, uint8_t value) const;
-    bool WriteByte(const std::optional<uintptr_t>& addr, uint8_t value) const;
-    bool WriteByte(const std::optional<uintptr_t>& addr, int offset, uint8_t value) const;
+    bool ReadBytes(uintptr_t addr, std::span<uint8_t> out) const;
+    bool ReadBytes(uintptr_t addr, int offset, std::span<uint8_t> out) const;
+    bool ReadBytes(const std::optional<uintptr_t>& addr, std::span<uint8_t> out) const;
+
+    bool ReadStringInto(uintptr_t addr, std::string& out, size_t maxLength) const;
+    bool ReadStringInto(const std::optional<uintptr_t>& addr, std::string& out, size_t maxLength) const;
+    bool ReadWStringInto(uintptr_t addr, std::wstring& out, size_t maxLength) const;
+    bool ReadWStringInto(const std::optional<uintptr_t>& addr, std::wstring& out, size_t maxLength) const;
+
+    // A string cut off by an unreadable page is returned as far as it was read, with the failing call's error
+    ReadResult<std::string> TryReadString(uintptr_t addr, size_t maxLength) const;
+    ReadResult<std::string> TryReadString(const std::optional<uintptr_t>& addr, size_t maxLength) const;
+    ReadResult<std::wstring> TryReadWString(uintptr_t addr, size_t maxLength) const;
+    ReadResult<std::wstring> TryReadWString(const std::optional<uintptr_t>& addr, size_t maxLength) const;
+    ReadResult<std::vector<uint8_t>> TryReadBytes(uintptr_t addr, size_t sz) const;
+    ReadResult<std::vector<uint8_t>> TryReadBytes(const std::optional<uintptr_t>& addr, size_t sz) const;
+
+    // Results allocated from resource, e.g. GetFrameArena(); nullptr means the default resource
+    std::pmr::vector<uint8_t> ReadBytes(uintptr_t addr, size_t sz, std::pmr::memory_resource* resource) const;
+    std::pmr::vector<uint8_t> ReadBytes(const std::optional<uintptr_t>& addr, size_t sz, std::pmr::memory_resource* resource) const;
+    std::pmr::string ReadString(uintptr_t addr, size_t length, std::pmr::memory_resource* resource) const;
+    std::pmr::string ReadString(const std::optional<uintptr_t>& addr, size_t length, std::pmr::memory_resource* resource) const;
+    std::pmr::wstring ReadWString(uintptr_t addr, size_t length, std::pmr::memory_resource* resource) const;
+    std::pmr::wstring ReadWString(const std::optional<uintptr_t>& addr, size_t length, std::pmr::memory_resource* resource) const;
+
+    // The calling thread's arena for this phantom. Reset it once per frame from that thread;
+    // it is released when the thread exits.
+    FrameArena& GetFrameArena() const;
+
+    template<size_t Capacity>
+    FixedString<Capacity> ReadFixedString(uintptr_t addr) const {
+        FixedString<Capacity> result;
+        DWORD error;
+        result.length = InternalReadTerminated(addr, result.chars, Capacity, sizeof(char), error);
+        result.chars[result.length] = '\0';
+        return result;
+    }
+
+    template<size_t Capacity>
+    FixedString<Capacity> ReadFixedString(const std::optional<uintptr_t>& addr) const {
+        return addr ? ReadFixedString<Capacity>(*addr) : FixedString<Capacity>();
+    }
+
+    size_t ReadScatter(std::span<ReadRequest> requests) const;
+    size_t Execute(ReadBatch& batch) const;
+    size_t Execute(WriteBatch& batch) const;
+
+    bool WriteInt(uintptr_t addr, int value) const { return Write<int>(addr, value); }
+    bool WriteInt(uintptr_t addr, int offset, int value) const { return Write<int>(addr, offset, value); }
+    bool WriteInt(const std::optional<uintptr_t>& addr, int value) const { return Write<int>(addr, value); }
+    bool WriteInt(const std::optional<uintptr_t>& addr, int offset, int value) const { return Write<int>(addr, offset, value); }
+
+    bool WriteFloat(uintptr_t addr, float value) const { return Write<float>(addr, value); }
+    bool WriteFloat(uintptr_t addr, int offset, float value) const { return Write<float>(addr, offset, value); }
+    bool WriteFloat(const std::optional<uintptr_t>& addr, float value) const { return Write<float>(addr, value); }
+    bool WriteFloat(const std::optional<uintptr_t>& addr, int offset, float value) const { return Write<float>(addr, offset, value); }
+
+    bool WriteDouble(uintptr_t addr, double value) const { return Write<double>(addr, value); }
+    bool WriteDouble(uintptr_t addr, int offset, double value) const { return Write<double>(addr, offset, value); }
+    bool WriteDouble(const std::optional<uintptr_t>& addr, double value) const { return Write<double>(addr, value); }
+    bool WriteDouble(const std::optional<uintptr_t>& addr, int offset, double value) const { return Write<double>(addr, offset, value); }
+
+    bool WriteShort(uintptr_t addr, short value) const { return Write<short>(addr, value); }
+    bool WriteShort(uintptr_t addr, int offset, short value) const { return Write<short>(addr, offset, value); }
+    bool WriteShort(const std::optional<uintptr_t>& addr, short value) const { return Write<short>(addr, value); }
+    bool WriteShort(const std::optional<uintptr_t>& addr, int offset, short value) const { return Write<short>(addr, offset, value); }
+
+    bool WriteUShort(uintptr_t addr, unsigned short value) const { return Write<unsigned short>(addr, value); }
+    bool WriteUShort(uintptr_t addr, int offset, unsigned short value) const { return Write<unsigned short>(addr, offset, value); }
+    bool WriteUShort(const std::optional<uintptr_t>& addr, unsigned short value) const { return Write<unsigned short>(addr, value); }
+    bool WriteUShort(const std::optional<uintptr_t>& addr, int offset, unsigned short value) const { return Write<unsigned short>(addr, offset, value); }
+
+    bool WriteUInt(uintptr_t addr, unsigned int value) const { return Write<unsigned int>(addr, value); }
+    bool WriteUInt(uintptr_t addr, int offset, unsigned int value) const { return Write<unsigned int>(addr, offset, value); }
+    bool WriteUInt(const std::optional<uintptr_t>& addr, unsigned int value) const { return Write<unsigned int>(addr, value); }
+    bool WriteUInt(const std::optional<uintptr_t>& addr, int offset, unsigned int value) const { return Write<unsigned int>(addr, offset, value); }
+
+    bool WriteULong(uintptr_t addr, uint64_t value) const { return Write<uint64_t>(addr, value); }
+    bool WriteULong(uintptr_t addr, int offset, uint64_t value) const { return Write<uint64_t>(addr, offset, value); }
+    bool WriteULong(const std::optional<uintptr_t>& addr, uint64_t value) const { return Write<uint64_t>(addr, value); }
+    bool WriteULong(const std::optional<uintptr_t>& addr, int offset, uint64_t value) const { return Write<uint64_t>(addr, offset, value); }
+
+    bool WriteLong(uintptr_t addr, int64_t value) const { return Write<int64_t>(addr, value); }
+    bool WriteLong(uintptr_t addr, int offset, int64_t value) const { return Write<int64_t>(addr, offset, value); }
+    bool WriteLong(const std::optional<uintptr_t>& addr, int64_t value) const { return Write<int64_t>(addr, value); }
+    bool WriteLong(const std::optional<uintptr_t>& addr, int offset, int64_t value) const { return Write<int64_t>(addr, offset, value); }
+
+    bool WriteBool(uintptr_t addr, bool value) const { return Write<bool>(addr, value); }
+    bool WriteBool(uintptr_t addr, int offset, bool value) const { return Write<bool>(addr, offset, value); }
+    bool WriteBool(const std::optional<uintptr_t>& addr, bool value) const { return Write<bool>(addr, value); }
+    bool WriteBool(const std::optional<uintptr_t>& addr, int offset, bool value) const { return Write<bool>(addr, offset, value); }
+
+    bool WriteChar(uintptr_t addr, char value) const { return Write<char>(addr, value); }
+    bool WriteChar(uintptr_t addr, int offset, char value) const { return Write<char>(addr, offset, value); }
+    bool WriteChar(const std::optional<uintptr_t>& addr, char value) const { return Write<char>(addr, value); }
+    bool WriteChar(const std::optional<uintptr_t>& addr, int offset, char value) const { return Write<char>(addr, offset, value); }
+
+    bool WriteByte(uintptr_t addr, uint8_t value) const { return Write<uint8_t>(addr, value); }
+    bool WriteByte(uintptr_t addr, int offset, uint8_t value) const { return Write<uint8_t>(addr, offset, value); }
+    bool WriteByte(const std::optional<uintptr_t>& addr, uint8_t value) const { return Write<uint8_t>(addr, value); }
+    bool WriteByte(const std::optional<uintptr_t>& addr, int offset, uint8_t value) const { return Write<uint8_t>(addr, offset, value); }
 
     bool WriteString(uintptr_t addr, const std::string& value) const;
     bool WriteString(uintptr_t addr, int offset, const std::string& value) const;
@@ -209,87 +797,161 @@ public:
     bool WriteWString(const std::optional<uintptr_t>& addr, const std::wstring& value) const;
     bool WriteWString(const std::optional<uintptr_t>& addr, int offset, const std::wstring& value) const;
 
-    bool WriteVec3(uintptr_t addr, const Vector3& vec) const;
-    bool WriteVec3(uintptr_t addr, int offset, const Vector3& vec) const;
-    bool WriteVec3(const std::optional<uintptr_t>& addr, const Vector3& vec) const;
-    bool WriteVec3(const std::optional<uintptr_t>& addr, int offset, const Vector3& vec) const;
+    bool WriteVec3(uintptr_t addr, const Vector3& vec) const { return Write<Vector3>(addr, vec); }
+    bool WriteVec3(uintptr_t addr, int offset, const Vector3& vec) const { return Write<Vector3>(addr, offset, vec); }
+    bool WriteVec3(const std::optional<uintptr_t>& addr, const Vector3& vec) const { return Write<Vector3>(addr, vec); }
+    bool WriteVec3(const std::optional<uintptr_t>& addr, int offset, const Vector3& vec) const { return Write<Vector3>(addr, offset, vec); }
 
-    bool WriteMatrix(uintptr_t addr, const Mat4x4& matrix) const;
-    bool WriteMatrix(uintptr_t addr, int offset, const Mat4x4& matrix) const;
-    bool WriteMatrix(const std::optional<uintptr_t>& addr, const Mat4x4& matrix) const;
-    bool WriteMatrix(const std::optional<uintptr_t>& addr, int offset, const Mat4x4& matrix) const;
+    bool WriteMatrix(uintptr_t addr, const Mat4x4& matrix) const { return Write<Mat4x4>(addr, matrix); }
+    bool WriteMatrix(uintptr_t addr, int offset, const Mat4x4& matrix) const { return Write<Mat4x4>(addr, offset, matrix); }
+    bool WriteMatrix(const std::optional<uintptr_t>& addr, const Mat4x4& matrix) const { return Write<Mat4x4>(addr, matrix); }
+    bool WriteMatrix(const std::optional<uintptr_t>& addr, int offset, const Mat4x4& matrix) const { return Write<Mat4x4>(addr, offset, matrix); }
 
     bool WriteBytes(uintptr_t addr, const std::vector<uint8_t>& data) const;
     bool WriteBytes(uintptr_t addr, int offset, const std::vector<uint8_t>& data) const;
     bool WriteBytes(const std::optional<uintptr_t>& addr, const std::vector<uint8_t>& data) const;
     bool WriteBytes(const std::optional<uintptr_t>& addr, int offset, const std::vector<uint8_t>& data) const;
 
-    template<typename T>
+    // The single typed read path; on failure the result is value-initialized (0, false, a zero vector)
+    template<RemoteReadable T>
     T Read(uintptr_t addr) const {
-        if constexpr (std::is_same_v<T, int>) return ReadInt(addr);
-        else if constexpr (std::is_same_v<T, float>) return ReadFloat(addr);
-        else if constexpr (std::is_same_v<T, double>) return ReadDouble(addr);
-        else if constexpr (std::is_same_v<T, short>) return ReadShort(addr);
-        else if constexpr (std::is_same_v<T, unsigned short>) return ReadUShort(addr);
-        else if constexpr (std::is_same_v<T, unsigned int>) return ReadUInt(addr);
-        else if constexpr (std::is_same_v<T, uint64_t>) return ReadULong(addr);
-        else if constexpr (std::is_same_v<T, int64_t>) return ReadLong(addr);
-        else if constexpr (std::is_same_v<T, bool>) return ReadBool(addr);
-        else if constexpr (std::is_same_v<T, char>) return ReadChar(addr);
-        else if constexpr (std::is_same_v<T, uint8_t>) return ReadByte(addr);
-        else if constexpr (std::is_same_v<T, uintptr_t>) return ReadPtr(addr);
+        if constexpr (RemoteLayout<T>::defined) {
+            T value{};
+            DWORD error;
+            InternalReadLayout(addr, value, error);
+            return value;
+        }
         else {
             T value;
-            InternalRead(addr, value);
-            return value;
+            if (InternalReadRaw(addr, &value, sizeof(T))) return value;
+            return T();
         }
     }
 
-    template<typename T>
+    template<RemoteReadable T>
     T Read(uintptr_t addr, int offset) const {
         return Read<T>(addr + offset);
     }
 
-    template<typename T>
+    template<RemoteReadable T>
     T Read(const std::optional<uintptr_t>& addr) const {
         return addr ? Read<T>(*addr) : T();
     }
 
-    template<typename T>
+    template<RemoteReadable T>
     T Read(const std::optional<uintptr_t>& addr, int offset) const {
         return addr ? Read<T>(*addr + offset) : T();
     }
 
+    // Same single read as Read<T>, but tells a zero value apart from a failure
+    template<RemoteReadable T>
+    ReadResult<T> TryRead(uintptr_t addr) const {
+        ReadResult<T> result;
+        if constexpr (RemoteLayout<T>::defined) {
+            result.bytesRead = InternalReadLayout(addr, result.value, result.error);
+            if (!result.Ok()) result.value = T{};
+        }
+        else {
+            result.bytesRead = InternalReadRaw(addr, &result.value, sizeof(T), result.error);
+            if (!result.Ok()) result.value = T();
+        }
+        return result;
+    }
+
+    template<RemoteReadable T>
+    ReadResult<T> TryRead(uintptr_t addr, int offset) const {
+        return TryRead<T>(addr + offset);
+    }
+
+    template<RemoteReadable T>
+    ReadResult<T> TryRead(const std::optional<uintptr_t>& addr) const {
+        return addr ? TryRead<T>(*addr) : ReadResult<T>{ T(), ERROR_INVALID_ADDRESS, 0 };
+    }
+
+    template<RemoteReadable T>
+    ReadResult<T> TryRead(const std::optional<uintptr_t>& addr, int offset) const {
+        return addr ? TryRead<T>(*addr + offset) : ReadResult<T>{ T(), ERROR_INVALID_ADDRESS, 0 };
+    }
+
+    // Reads up to min(count, out.size()) elements in one call, returns how many leading elements were read
     template<typename T>
-    bool Write(uintptr_t addr, const T& value) const {
-        if constexpr (std::is_same_v<T, int>) return WriteInt(addr, value);
-        else if constexpr (std::is_same_v<T, float>) return WriteFloat(addr, value);
-        else if constexpr (std::is_same_v<T, double>) return WriteDouble(addr, value);
-        else if constexpr (std::is_same_v<T, short>) return WriteShort(addr, value);
-        else if constexpr (std::is_same_v<T, unsigned short>) return WriteUShort(addr, value);
-        else if constexpr (std::is_same_v<T, unsigned int>) return WriteUInt(addr, value);
-        else if constexpr (std::is_same_v<T, uint64_t>) return WriteULong(addr, value);
-        else if constexpr (std::is_same_v<T, int64_t>) return WriteLong(addr, value);
-        else if constexpr (std::is_same_v<T, bool>) return WriteBool(addr, value);
-        else if constexpr (std::is_same_v<T, char>) return WriteChar(addr, value);
-        else if constexpr (std::is_same_v<T, uint8_t>) return WriteByte(addr, value);
-        else return InternalWrite(addr, value);
+    size_t ReadArray(uintptr_t addr, size_t count, std::span<T> out) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ReadArray requires a trivially copyable type");
+        static_assert(!RemoteLayout<T>::defined, "ReadArray copies raw elements; read RemoteLayout types with Read<T>");
+
+        count = std::min(count, out.size());
+        if (count == 0) return 0;
+
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(out.data());
+        const size_t total = count * sizeof(T);
+        if (InternalReadRaw(addr, bytes, total)) return count;
+
+        size_t done = 0;
+        while (done < total) {
+            size_t step = std::min(total - done, PageSize - (addr + done) % PageSize);
+            if (!InternalReadRaw(addr + done, bytes + done, step)) break;
+            done += step;
+        }
+        return done / sizeof(T);
     }
 
     template<typename T>
+    size_t ReadArray(uintptr_t addr, std::span<T> out) const {
+        return ReadArray<T>(addr, out.size(), out);
+    }
+
+    template<typename T>
+    size_t ReadArray(const std::optional<uintptr_t>& addr, size_t count, std::span<T> out) const {
+        return addr ? ReadArray<T>(*addr, count, out) : 0;
+    }
+
+    template<RemoteValue T>
+    bool Write(uintptr_t addr, const T& value) const {
+        return InternalWriteRaw(addr, &value, sizeof(T));
+    }
+
+    template<RemoteValue T>
     bool Write(uintptr_t addr, int offset, const T& value) const {
         return Write<T>(addr + offset, value);
     }
 
-    template<typename T>
+    template<RemoteValue T>
     bool Write(const std::optional<uintptr_t>& addr, const T& value) const {
         return addr ? Write<T>(*addr, value) : false;
     }
 
-    template<typename T>
+    template<RemoteValue T>
     bool Write(const std::optional<uintptr_t>& addr, int offset, const T& value) const {
         return addr ? Write<T>(*addr + offset, value) : false;
     }
 };
 
+// Reference-counted, read-only view of one attached process for sharing across threads.
+// Every const member of MemoryPhantom is safe to call concurrently.
+class SharedPhantom {
+public:
+    SharedPhantom() = default;
+    explicit SharedPhantom(MemoryPhantom&& phantom) : phantom(std::make_shared<const MemoryPhantom>(std::move(phantom))) {}
+
+    static SharedPhantom Attach(DWORD pid, AccessRequest access = PROCESS_ALL_ACCESS) {
+        MemoryPhantom attached(pid, access);
+        return attached.IsActive() ? SharedPhantom(std::move(attached)) : SharedPhantom();
+    }
+
+    static SharedPhantom CreateFromName(const char* processName, AccessRequest access = PROCESS_ALL_ACCESS) {
+        auto attached = MemoryPhantom::CreateFromName(processName, access);
+        return attached ? SharedPhantom(std::move(*attached)) : SharedPhantom();
+    }
+
+    const MemoryPhantom& operator*() const { return *phantom; }
+    const MemoryPhantom* operator->() const { return phantom.get(); }
+    const MemoryPhantom* Get() const { return phantom.get(); }
+
+    explicit operator bool() const { return phantom && phantom->IsActive(); }
+    long UseCount() const { return phantom.use_count(); }
+
+private:
+    std::shared_ptr<const MemoryPhantom> phantom;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "MemoryScanner.h"
+
+MemoryScanner::MemoryScanner(const MemoryPhantom& phantom, size_t threadCount)
+    : phantom(phantom), ownedPool(std::make_unique<ThreadPool>(threadCount)), pool(ownedPool.get()) {}
+
+MemoryScanner::MemoryScanner(const MemoryPhantom& phantom, ThreadPool& pool)
+    : phantom(phantom), pool(&pool) {}
+
+bool MemoryScanner::ReadRaw(uintptr_t addr, void* buffer, size_t size) const {
+    if (!phantom.IsActive() || addr == 0 || size == 0) return false;
+    return phantom.InternalReadDirect(addr, buffer, size);
+}
+
+std::vector<MemoryRegion> MemoryScanner::Regions(const ScanOptions& options) const {
+    std::shared_ptr<const RegionMap> map = phantom.GetRegionMap();
+    std::vector<MemoryRegion> regions = map ? map->Regions(options.start, options.end, true) : phantom.QueryRegions(options.start, options.end, true);
+
+    regions.erase(std::remove_if(regions.begin(), regions.end(), [&](const MemoryRegion& region) {
+        if (options.writableOnly && !region.IsWritable()) return true;
+        if (region.type == MEM_IMAGE) return !options.includeImage;
+        if (region.type == MEM_MAPPED) return !options.includeMapped;
+        if (region.type == MEM_PRIVATE) return !options.includePrivate;
+        return false;
+    }), regions.end());
+    return regions;
+}
+
+std::vector<uintptr_t> MemoryScanner::Scan(size_t overlap, const ScanOptions& options, const ChunkMatcher& matcher) const {
+    struct Chunk {
+        uintptr_t base;
+        size_t own;
+        size_t readLength;
+    };
+
+    std::vector<uintptr_t> merged;
+    if (!phantom.IsActive()) return merged;
+
+    const size_t chunkSize = std::max(options.chunkSize, MemoryPhantom::PageSize);
+    std::vector<Chunk> chunks;
+    for (const MemoryRegion& region : Regions(options)) {
+        uintptr_t start = std::max(region.base, options.start);
+        uintptr_t end = std::min(region.End(), options.end);
+        for (uintptr_t addr = start; addr < end; addr += chunkSize) {
+            size_t own = std::min(chunkSize, static_cast<size_t>(end - addr));
+            chunks.push_back({ addr, own, std::min(own + overlap, static_cast<size_t>(end - addr)) });
+        }
+    }
+
+    std::vector<std::vector<uintptr_t>> results(chunks.size());
+    pool->ParallelFor(chunks.size(), [&](size_t index) {
+        thread_local std::vector<uint8_t> buffer;
+        const Chunk& chunk = chunks[index];
+
+        buffer.resize(chunk.readLength);
+        if (phantom.InternalReadDirect(chunk.base, buffer.data(), chunk.readLength)) {
+            matcher(chunk.base, buffer.data(), chunk.own, chunk.readLength, results[index]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& result : results) total += result.size();
+    merged.reserve(total);
+    for (const auto& result : results) merged.insert(merged.end(), result.begin(), result.end());
+    return merged;
+}
+
+std::vector<uintptr_t> MemoryScanner::ScanPattern(const BytePattern& pattern, const ScanOptions& options) const {
+    if (pattern.Size() == 0) return std::vector<uintptr_t>();
+
+    return Scan(pattern.Size() - 1, options, [&pattern](uintptr_t base, const uint8_t* data, size_t own, size_t readLength, std::vector<uintptr_t>& matches) {
+        for (size_t pos = pattern.Find(data, readLength); pos != BytePattern::npos && pos < own; pos = pattern.Find(data, readLength, pos + 1)) {
+            matches.push_back(base + pos);
+        }
+    });
+}
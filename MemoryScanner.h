@@ -0,0 +1,60 @@
+#ifndef MEMORYSCANNER_H
+#define MEMORYSCANNER_H
+
+#include "MemoryPhantom.h"
+#include "ThreadPool.h"
+#include <functional>
+
+struct ScanOptions {
+    uintptr_t start = 0;
+    uintptr_t end = UINTPTR_MAX;
+    size_t alignment = 0;
+    size_t chunkSize = 1024 * 1024;
+    bool writableOnly = false;
+    bool includeImage = true;
+    bool includeMapped = true;
+    bool includePrivate = true;
+};
+
+class MemoryScanner {
+public:
+    // data covers [base, base + readLength); only matches starting before base + own belong to this chunk
+    using ChunkMatcher = std::function<void(uintptr_t base, const uint8_t* data, size_t own, size_t readLength, std::vector<uintptr_t>& matches)>;
+
+    explicit MemoryScanner(const MemoryPhantom& phantom, size_t threadCount = 0);
+    MemoryScanner(const MemoryPhantom& phantom, ThreadPool& pool);
+
+    MemoryScanner(const MemoryScanner&) = delete;
+    MemoryScanner& operator=(const MemoryScanner&) = delete;
+
+    std::vector<MemoryRegion> Regions(const ScanOptions& options = ScanOptions()) const;
+    std::vector<uintptr_t> Scan(size_t overlap, const ScanOptions& options, const ChunkMatcher& matcher) const;
+    std::vector<uintptr_t> ScanPattern(const BytePattern& pattern, const ScanOptions& options = ScanOptions()) const;
+
+    template<typename T>
+    std::vector<uintptr_t> ScanValue(const T& value, const ScanOptions& options = ScanOptions()) const {
+        static_assert(std::is_trivially_copyable_v<T>, "ScanValue requires a trivially copyable type");
+
+        const size_t alignment = options.alignment ? options.alignment : alignof(T);
+        return Scan(sizeof(T) - 1, options, [&value, alignment](uintptr_t base, const uint8_t* data, size_t own, size_t readLength, std::vector<uintptr_t>& matches) {
+            size_t offset = (alignment - base % alignment) % alignment;
+            for (; offset < own && offset + sizeof(T) <= readLength; offset += alignment) {
+                if (memcmp(data + offset, &value, sizeof(T)) == 0) {
+                    matches.push_back(base + offset);
+                }
+            }
+        });
+    }
+
+    bool ReadRaw(uintptr_t addr, void* buffer, size_t size) const;
+
+    const MemoryPhantom& Phantom() const { return phantom; }
+    ThreadPool& Pool() const { return *pool; }
+
+private:
+    const MemoryPhantom& phantom;
+    std::unique_ptr<ThreadPool> ownedPool;
+    ThreadPool* pool;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "PatternScanner.h"
+#include <cctype>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define PHANTOM_PATTERN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHANTOM_PATTERN_SSE2
+#endif
+
+namespace {
+    int HexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    inline unsigned CountTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return index;
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+}
+
+std::optional<BytePattern> BytePattern::Parse(const char* pattern) {
+    if (!pattern) return std::nullopt;
+
+    BytePattern result;
+    const char* p = pattern;
+    while (*p) {
+        if (isspace(static_cast<unsigned char>(*p))) {
+            p++;
+            continue;
+        }
+
+        char hi = *p++;
+        char lo = (*p && !isspace(static_cast<unsigned char>(*p))) ? *p++ : '\0';
+        if (*p && !isspace(static_cast<unsigned char>(*p))) return std::nullopt;
+
+        if (hi == '?' && (lo == '\0' || lo == '?')) {
+            result.bytes.push_back(0);
+            result.mask.push_back(0);
+            continue;
+        }
+        if (lo == '\0') return std::nullopt;
+
+        uint8_t value = 0;
+        uint8_t mask = 0;
+        if (hi != '?') {
+            int v = HexValue(hi);
+            if (v < 0) return std::nullopt;
+            value |= static_cast<uint8_t>(v << 4);
+            mask |= 0xF0;
+        }
+        if (lo != '?') {
+            int v = HexValue(lo);
+            if (v < 0) return std::nullopt;
+            value |= static_cast<uint8_t>(v);
+            mask |= 0x0F;
+        }
+        result.bytes.push_back(value);
+        result.mask.push_back(mask);
+    }
+
+    if (result.bytes.empty()) return std::nullopt;
+    result.SelectAnchors();
+    return result;
+}
+
+BytePattern BytePattern::FromMask(const uint8_t* data, const char* mask) {
+    BytePattern result;
+    size_t length = strlen(mask);
+    result.bytes.resize(length);
+    result.mask.resize(length);
+    for (size_t i = 0; i < length; i++) {
+        result.mask[i] = mask[i] == 'x' ? 0xFF : 0x00;
+        result.bytes[i] = data[i] & result.mask[i];
+    }
+    result.SelectAnchors();
+    return result;
+}
+
+void BytePattern::SelectAnchors() {
+    hasAnchor = false;
+    for (size_t i = 0; i < mask.size(); i++) {
+        if (mask[i] != 0xFF) continue;
+        if (!hasAnchor) {
+            anchor = i;
+            hasAnchor = true;
+        }
+        secondAnchor = i;
+    }
+}
+
+bool BytePattern::Matches(const uint8_t* data) const {
+    for (size_t i = 0; i < bytes.size(); i++) {
+        if ((data[i] & mask[i]) != bytes[i]) return false;
+    }
+    return true;
+}
+
+size_t BytePattern::FindScalar(const uint8_t* data, size_t size, size_t from) const {
+    for (size_t i = from; i + bytes.size() <= size; i++) {
+        if (hasAnchor && (data[i + anchor] != bytes[anchor] || data[i + secondAnchor] != bytes[secondAnchor])) continue;
+        if (Matches(data + i)) return i;
+    }
+    return npos;
+}
+
+size_t BytePattern::Find(const uint8_t* data, size_t size, size_t from) const {
+    if (bytes.empty() || size < bytes.size() || from > size - bytes.size()) return npos;
+    if (!hasAnchor) return FindScalar(data, size, from);
+
+    size_t i = from;
+
+#if defined(PHANTOM_PATTERN_AVX2)
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(bytes[anchor]));
+    const __m256i second = _mm256_set1_epi8(static_cast<char>(bytes[secondAnchor]));
+    for (; i + bytes.size() + 31 <= size; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + anchor));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + secondAnchor));
+        uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, second))));
+        while (hits) {
+            size_t candidate = i + CountTrailingZeros(hits);
+            if (Matches(data + candidate)) return candidate;
+            hits &= hits - 1;
+        }
+    }
+#elif defined(PHANTOM_PATTERN_SSE2)
+    const __m128i first = _mm_set1_epi8(static_cast<char>(bytes[anchor]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(bytes[secondAnchor]));
+    for (; i + bytes.size() + 15 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + anchor));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + secondAnchor));
+        uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, second))));
+        while (hits) {
+            size_t candidate = i + CountTrailingZeros(hits);
+            if (Matches(data + candidate)) return candidate;
+            hits &= hits - 1;
+        }
+    }
+#endif
+
+    return FindScalar(data, size, i);
+}
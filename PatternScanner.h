@@ -0,0 +1,33 @@
+#ifndef PATTERNSCANNER_H
+#define PATTERNSCANNER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+struct BytePattern {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;
+
+    // "48 8B ?? ?? 89", "?" and "??" are full wildcards, "4?" / "?8" mask a single nibble
+    static std::optional<BytePattern> Parse(const char* pattern);
+    // Code-style: bytes plus "xx??x" mask, 'x' = must match
+    static BytePattern FromMask(const uint8_t* data, const char* mask);
+
+    size_t Size() const { return bytes.size(); }
+    bool Matches(const uint8_t* data) const;
+    size_t Find(const uint8_t* data, size_t size, size_t from = 0) const;
+
+private:
+    size_t anchor = 0;
+    size_t secondAnchor = 0;
+    bool hasAnchor = false;
+
+    void SelectAnchors();
+    size_t FindScalar(const uint8_t* data, size_t size, size_t from) const;
+};
+
+#endif
@@ -0,0 +1,299 @@
+#include "PhantomManager.h"
+
+PhantomManager::PhantomManager(size_t threadCount, AccessRequest access, size_t queueCapacity)
+    : pool(threadCount), access(access), queueCapacity(std::max<size_t>(queueCapacity, 1)) {}
+
+PhantomManager::~PhantomManager() {
+    Stop();
+}
+
+bool PhantomManager::Add(DWORD pid) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (targets.count(pid)) return false;
+
+        // Without an image name the target cannot be reattached and is dropped when it exits
+        index.Refresh();
+        const ProcessEntry* entry = index.Get(pid);
+        if (!AddLocked(pid, entry ? entry->name : std::wstring())) return false;
+        scheduleChanged = true;
+    }
+    wake.notify_one();
+    return true;
+}
+
+size_t PhantomManager::AddAll(std::wstring_view processName) {
+    size_t added = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!index.Refresh()) return 0;
+        for (DWORD pid : index.FindAll(processName)) {
+            if (!targets.count(pid) && AddLocked(pid, index.Get(pid)->name)) added++;
+        }
+        if (added) scheduleChanged = true;
+    }
+    if (added) wake.notify_one();
+    return added;
+}
+
+bool PhantomManager::AddLocked(DWORD pid, const std::wstring& name) {
+    auto phantom = std::make_shared<MemoryPhantom>();
+    if (!phantom->Attach(pid, access)) return false;
+
+    auto target = std::make_shared<Target>();
+    target->name = name;
+    target->pid = pid;
+    target->grantedAccess = phantom->GetGrantedAccess();
+    target->phantom = std::move(phantom);
+    targets.emplace(pid, std::move(target));
+    return true;
+}
+
+AccessRequest PhantomManager::ReattachRequest(DWORD grantedAccess) const {
+    if (!access.IsProfile()) return access;
+    auto granted = ProfileFor(grantedAccess);
+    if (!granted || *granted < access.minimum) return access;
+    return AccessRequest(std::min(*granted, access.preferred), access.minimum);
+}
+
+// A target whose process exited waits in lost under its old PID until it is found again
+bool PhantomManager::Remove(DWORD pid) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t removed = targets.erase(pid);
+    removed += std::erase_if(lost, [pid](const std::shared_ptr<Target>& target) {
+        std::lock_guard<std::mutex> targetLock(target->mutex);
+        return target->pid == pid;
+    });
+    return removed > 0;
+}
+
+std::vector<DWORD> PhantomManager::Pids() const {
+    std::vector<DWORD> pids;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pids.reserve(targets.size());
+        for (const auto& entry : targets) pids.push_back(entry.first);
+    }
+    std::sort(pids.begin(), pids.end());
+    return pids;
+}
+
+size_t PhantomManager::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return targets.size();
+}
+
+std::shared_ptr<PhantomManager::Target> PhantomManager::Find(DWORD pid) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = targets.find(pid);
+    return it != targets.end() ? it->second : nullptr;
+}
+
+std::vector<std::shared_ptr<PhantomManager::Target>> PhantomManager::Targets() const {
+    std::vector<std::shared_ptr<Target>> result;
+    std::lock_guard<std::mutex> lock(mutex);
+    result.reserve(targets.size());
+    for (const auto& entry : targets) result.push_back(entry.second);
+    return result;
+}
+
+std::shared_ptr<const MemoryPhantom> PhantomManager::Get(DWORD pid) const {
+    auto target = Find(pid);
+    if (!target) return nullptr;
+    std::lock_guard<std::mutex> lock(target->mutex);
+    return target->phantom;
+}
+
+void PhantomManager::SetReattachHandler(ReattachHandler handler) {
+    std::lock_guard<std::mutex> lock(mutex);
+    reattachHandler = std::move(handler);
+}
+
+size_t PhantomManager::WatchBytes(DWORD pid, uintptr_t addr, size_t size, Clock::duration interval) {
+    if (addr == 0 || size == 0 || size > WatchChange::MaxValueSize) return 0;
+    auto target = Find(pid);
+    if (!target) return 0;
+
+    size_t id = nextWatchId.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(target->mutex);
+        target->watches.Add(id, addr, size, interval);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduleChanged = true;
+    }
+    wake.notify_one();
+    return id;
+}
+
+bool PhantomManager::Unwatch(DWORD pid, size_t id) {
+    auto target = Find(pid);
+    if (!target) return false;
+
+    std::lock_guard<std::mutex> lock(target->mutex);
+    return target->watches.Remove(id);
+}
+
+bool PhantomManager::Poll(ManagedChange& out) {
+    std::lock_guard<std::mutex> lock(changeMutex);
+    if (changes.empty()) return false;
+    out = changes.front();
+    changes.pop_front();
+    return true;
+}
+
+void PhantomManager::Publish(const ManagedChange& change) {
+    std::lock_guard<std::mutex> lock(changeMutex);
+    if (changes.size() >= queueCapacity) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    changes.push_back(change);
+}
+
+std::future<size_t> PhantomManager::Execute(DWORD pid, ReadBatch& batch) {
+    auto promise = std::make_shared<std::promise<size_t>>();
+    std::future<size_t> future = promise->get_future();
+
+    auto phantom = Get(pid);
+    if (!phantom) {
+        promise->set_value(0);
+        return future;
+    }
+    pool.Submit([phantom = std::move(phantom), &batch, promise] { promise->set_value(phantom->Execute(batch)); });
+    return future;
+}
+
+size_t PhantomManager::Execute(std::span<TargetBatch> batches) {
+    std::atomic<size_t> total{ 0 };
+    pool.ParallelFor(batches.size(), [&](size_t i) {
+        TargetBatch& entry = batches[i];
+        auto phantom = Get(entry.pid);
+        entry.succeeded = phantom && entry.batch ? phantom->Execute(*entry.batch) : 0;
+        total.fetch_add(entry.succeeded, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+PhantomManager::Clock::time_point PhantomManager::TickTarget(Target& target, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(target.mutex);
+    if (!target.phantom) return Clock::time_point::max();
+
+    Clock::time_point next = target.watches.Sample(*target.phantom, now, target.changed);
+    for (const WatchChange& change : target.changed) Publish({ target.pid, change });
+    return next;
+}
+
+// One process snapshot per pass serves every lost target, so a restart of many instances costs no more than one
+void PhantomManager::Reattach() {
+    std::vector<std::pair<DWORD, DWORD>> moved;
+    ReattachHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = targets.begin(); it != targets.end();) {
+            Target& target = *it->second;
+            std::lock_guard<std::mutex> targetLock(target.mutex);
+
+            // Handles without query rights cannot report an exit and are treated as alive
+            DWORD code = 0;
+            bool exited = GetExitCodeProcess(target.phantom->GetHandle(), &code) && code != STILL_ACTIVE;
+            if (!exited) {
+                ++it;
+                continue;
+            }
+
+            target.phantom.reset();
+            if (!target.name.empty()) lost.push_back(it->second);
+            it = targets.erase(it);
+        }
+
+        if (!lost.empty() && index.Refresh()) {
+            for (auto it = lost.begin(); it != lost.end();) {
+                Target& target = **it;
+                std::lock_guard<std::mutex> targetLock(target.mutex);
+
+                auto phantom = std::make_shared<MemoryPhantom>();
+                DWORD previousPid = target.pid;
+                AccessRequest request = ReattachRequest(target.grantedAccess);
+                for (DWORD pid : index.FindAll(target.name)) {
+                    if (targets.count(pid) || !phantom->Attach(pid, request)) continue;
+
+                    target.pid = pid;
+                    target.grantedAccess = phantom->GetGrantedAccess();
+                    target.phantom = std::move(phantom);
+                    target.watches.Reprime(Clock::now());
+                    targets.emplace(pid, *it);
+                    moved.emplace_back(previousPid, pid);
+                    break;
+                }
+
+                if (target.phantom) it = lost.erase(it);
+                else ++it;
+            }
+        }
+        handler = reattachHandler;
+    }
+
+    if (handler) {
+        for (const auto& [previousPid, pid] : moved) handler(previousPid, pid);
+    }
+}
+
+PhantomManager::Clock::time_point PhantomManager::Tick() {
+    Clock::time_point now = Clock::now();
+    bool reattachDue;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scheduleChanged = false;
+        reattachDue = now >= nextReattach;
+        if (reattachDue) nextReattach = now + ReattachInterval;
+    }
+    if (reattachDue) Reattach();
+
+    std::vector<std::shared_ptr<Target>> active = Targets();
+    std::vector<Clock::time_point> due(active.size());
+    pool.ParallelFor(active.size(), [&](size_t i) { due[i] = TickTarget(*active[i], now); });
+
+    Clock::time_point next = Clock::time_point::max();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!targets.empty() || !lost.empty()) next = nextReattach;
+    }
+    for (Clock::time_point time : due) next = std::min(next, time);
+    return next;
+}
+
+void PhantomManager::Start() {
+    if (running.exchange(true)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = false;
+    }
+    scheduler = std::thread([this] { Run(); });
+}
+
+void PhantomManager::Stop() {
+    if (!running.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    scheduler.join();
+}
+
+void PhantomManager::Run() {
+    while (true) {
+        Clock::time_point next = Tick();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (next == Clock::time_point::max()) {
+            wake.wait(lock, [this] { return stopping || scheduleChanged; });
+        }
+        else {
+            wake.wait_until(lock, next, [this] { return stopping || scheduleChanged; });
+        }
+        if (stopping) return;
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef PHANTOMMANAGER_H
+#define PHANTOMMANAGER_H
+
+#include "MemoryPhantom.h"
+#include "ProcessIndex.h"
+#include "ThreadPool.h"
+#include "Watcher.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+
+struct ManagedChange {
+    DWORD pid;
+    WatchChange change;
+};
+
+struct TargetBatch {
+    DWORD pid;
+    ReadBatch* batch;
+    size_t succeeded;
+};
+
+// Owns one MemoryPhantom per attached process. Watches of every target are sampled on one shared ThreadPool,
+// and targets whose process exits are reattached to a new instance with the same image name.
+// A reattached target keeps its watches and is keyed by its new PID from then on.
+class PhantomManager {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ReattachHandler = std::function<void(DWORD previousPid, DWORD pid)>;
+
+    static constexpr std::chrono::milliseconds ReattachInterval = std::chrono::milliseconds(500);
+    static constexpr size_t DefaultQueueCapacity = 4096;
+
+    // With a profile request, a reattach starts at the profile the target was granted before,
+    // so a fallback is paid once per target instead of on every restart
+    explicit PhantomManager(size_t threadCount = 0, AccessRequest access = PROCESS_ALL_ACCESS,
+        size_t queueCapacity = DefaultQueueCapacity);
+    ~PhantomManager();
+
+    PhantomManager(const PhantomManager&) = delete;
+    PhantomManager& operator=(const PhantomManager&) = delete;
+
+    bool Add(DWORD pid);
+    // Attaches every running instance that is not managed yet, returns how many were added
+    size_t AddAll(std::wstring_view processName);
+    // Also drops a target that exited and is waiting to be reattached under this PID
+    bool Remove(DWORD pid);
+
+    std::vector<DWORD> Pids() const;
+    size_t Size() const;
+
+    // nullptr while the target is unknown or waiting to be reattached; a held phantom stays valid after a reattach
+    std::shared_ptr<const MemoryPhantom> Get(DWORD pid) const;
+
+    // Called on the scheduler thread after a target moved to a new process
+    void SetReattachHandler(ReattachHandler handler);
+
+    template<typename T>
+    size_t Watch(DWORD pid, uintptr_t addr, Clock::duration interval) {
+        static_assert(std::is_trivially_copyable_v<T>, "Watched values must be trivially copyable");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout cannot be watched as a block");
+        static_assert(sizeof(T) <= WatchChange::MaxValueSize, "Watched values are limited to MaxValueSize bytes");
+        return WatchBytes(pid, addr, sizeof(T), interval);
+    }
+
+    size_t WatchBytes(DWORD pid, uintptr_t addr, size_t size, Clock::duration interval);
+    bool Unwatch(DWORD pid, size_t id);
+
+    // Changes from every target; any thread may poll
+    bool Poll(ManagedChange& out);
+    uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Runs the batch on the pool; the batch must stay alive until the future is ready. Unknown PIDs yield 0.
+    std::future<size_t> Execute(DWORD pid, ReadBatch& batch);
+    // Runs every batch in parallel and returns the total number of succeeded requests
+    size_t Execute(std::span<TargetBatch> batches);
+
+    // Checks for exited targets when due, samples every due watch across the pool, returns when the next is due
+    Clock::time_point Tick();
+
+    void Start();
+    void Stop();
+    bool IsRunning() const { return running.load(std::memory_order_relaxed); }
+
+private:
+    struct Target {
+        std::wstring name;
+
+        // Guards everything below; held by the worker sampling this target
+        mutable std::mutex mutex;
+        DWORD pid;
+        DWORD grantedAccess;
+        std::shared_ptr<const MemoryPhantom> phantom;
+        WatchSet watches;
+        std::vector<WatchChange> changed;
+    };
+
+    std::shared_ptr<Target> Find(DWORD pid) const;
+    std::vector<std::shared_ptr<Target>> Targets() const;
+    bool AddLocked(DWORD pid, const std::wstring& name);
+    AccessRequest ReattachRequest(DWORD grantedAccess) const;
+    Clock::time_point TickTarget(Target& target, Clock::time_point now);
+    void Reattach();
+    void Publish(const ManagedChange& change);
+    void Run();
+
+    ThreadPool pool;
+    AccessRequest access;
+    size_t queueCapacity;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::unordered_map<DWORD, std::shared_ptr<Target>> targets;
+    std::vector<std::shared_ptr<Target>> lost;
+    ProcessIndex index;
+    ReattachHandler reattachHandler;
+    Clock::time_point nextReattach;
+    bool scheduleChanged = false;
+
+    std::atomic<size_t> nextWatchId{ 1 };
+
+    std::mutex changeMutex;
+    std::deque<ManagedChange> changes;
+    std::atomic<uint64_t> dropped{ 0 };
+
+    std::thread scheduler;
+    std::atomic<bool> running{ false };
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef POINTERCHAIN_H
+#define POINTERCHAIN_H
+
+#include "MemoryPhantom.h"
+
+// base + offsets {a, b, c} resolves to ReadPtr(ReadPtr(base + a) + b) + c.
+// Hop values are cached until the phantom's epoch advances (BeginFrame) or Invalidate() is called.
+class PointerChain {
+public:
+    PointerChain() = default;
+
+    PointerChain(uintptr_t base, std::vector<ptrdiff_t> offsets)
+        : base(base), offsets(std::move(offsets)), hops(Depth()) {}
+
+    template<typename... Offsets>
+        requires (std::is_integral_v<Offsets> && ...)
+    PointerChain(uintptr_t base, Offsets... offsets)
+        : PointerChain(base, std::vector<ptrdiff_t>{ static_cast<ptrdiff_t>(offsets)... }) {}
+
+    template<ptrdiff_t... Offsets>
+    static PointerChain Make(uintptr_t base) {
+        return PointerChain(base, std::vector<ptrdiff_t>{ Offsets... });
+    }
+
+    size_t Depth() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    uintptr_t Base() const { return base; }
+    bool IsResolved() const { return resolved; }
+
+    // The first `count` hops are kept across epochs and only re-read after Invalidate() or a failed walk
+    void Pin(size_t count) { pinned = std::min(count, Depth()); }
+
+    void Invalidate() {
+        resolved = false;
+        validHops = 0;
+    }
+
+    std::optional<uintptr_t> Resolve(const MemoryPhantom& phantom) {
+        if (resolved && epoch == phantom.GetEpoch()) return Final();
+
+        size_t start = std::min(pinned, validHops);
+        if (Walk(phantom, start) || (start > 0 && Walk(phantom, 0))) return Final();
+        return std::nullopt;
+    }
+
+    template<typename T>
+    T Read(const MemoryPhantom& phantom) {
+        auto addr = Resolve(phantom);
+        return addr ? phantom.Read<T>(*addr) : T();
+    }
+
+    template<typename T>
+    bool Write(const MemoryPhantom& phantom, const T& value) {
+        auto addr = Resolve(phantom);
+        return addr ? phantom.Write<T>(*addr, value) : false;
+    }
+
+    // Walks all stale chains level by level, one coalesced batch read per level instead of one syscall per hop
+    static size_t ResolveAll(const MemoryPhantom& phantom, std::span<PointerChain> chains) {
+        struct Walker {
+            PointerChain* chain;
+            size_t cursor;
+            bool retried;
+        };
+
+        thread_local ReadBatch batch;
+        thread_local std::vector<Walker> walkers;
+        walkers.clear();
+
+        size_t resolvedCount = 0;
+        for (PointerChain& chain : chains) {
+            if (chain.resolved && chain.epoch == phantom.GetEpoch()) {
+                resolvedCount++;
+                continue;
+            }
+            size_t start = std::min(chain.pinned, chain.validHops);
+            chain.resolved = false;
+            if (start == chain.Depth()) {
+                chain.Complete(phantom);
+                resolvedCount++;
+                continue;
+            }
+            walkers.push_back({ &chain, start, start == 0 });
+        }
+
+        while (!walkers.empty()) {
+            batch.Clear();
+            for (const Walker& walker : walkers) {
+                batch.Add(walker.chain->HopAddress(walker.cursor), walker.chain->hops[walker.cursor]);
+            }
+            phantom.Execute(batch);
+
+            size_t kept = 0;
+            for (size_t i = 0; i < walkers.size(); i++) {
+                Walker walker = walkers[i];
+                PointerChain& chain = *walker.chain;
+
+                if (batch.Succeeded(i) && chain.hops[walker.cursor] != 0) {
+                    if (++walker.cursor == chain.Depth()) {
+                        chain.Complete(phantom);
+                        resolvedCount++;
+                        continue;
+                    }
+                }
+                else {
+                    chain.validHops = std::min(chain.validHops, walker.cursor);
+                    if (walker.retried) continue;
+                    walker.cursor = 0;
+                    walker.retried = true;
+                }
+                walkers[kept++] = walker;
+            }
+            walkers.resize(kept);
+        }
+        return resolvedCount;
+    }
+
+private:
+    uintptr_t base = 0;
+    std::vector<ptrdiff_t> offsets;
+    std::vector<uintptr_t> hops;
+    size_t validHops = 0;
+    size_t pinned = 0;
+    uint64_t epoch = 0;
+    bool resolved = false;
+
+    uintptr_t HopAddress(size_t index) const {
+        return (index == 0 ? base : hops[index - 1]) + offsets[index];
+    }
+
+    uintptr_t Final() const {
+        if (offsets.empty()) return base;
+        return (Depth() == 0 ? base : hops.back()) + offsets.back();
+    }
+
+    void Complete(const MemoryPhantom& phantom) {
+        validHops = Depth();
+        epoch = phantom.GetEpoch();
+        resolved = true;
+    }
+
+    bool Walk(const MemoryPhantom& phantom, size_t start) {
+        resolved = false;
+        for (size_t i = start; i < Depth(); i++) {
+            uintptr_t value = phantom.ReadPtr(HopAddress(i));
+            if (!value) {
+                validHops = i;
+                return false;
+            }
+            hops[i] = value;
+        }
+        Complete(phantom);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,203 @@
+#include "ProcessIndex.h"
+#include <tlhelp32.h>
+#include <algorithm>
+#include <cwctype>
+
+namespace {
+    wchar_t FoldCase(wchar_t c) {
+        if (c < 0x80) return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c - L'A' + L'a') : c;
+        return static_cast<wchar_t>(std::towlower(c));
+    }
+
+    bool ContainsFolded(std::wstring_view text, std::wstring_view part) {
+        if (part.size() > text.size()) return false;
+        for (size_t start = 0; start + part.size() <= text.size(); start++) {
+            if (ProcessIndex::NamesEqual(text.substr(start, part.size()), part)) return true;
+        }
+        return false;
+    }
+}
+
+uint64_t ProcessIndex::HashName(std::wstring_view name) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (wchar_t c : name) {
+        hash ^= static_cast<uint16_t>(FoldCase(c));
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+bool ProcessIndex::NamesEqual(std::wstring_view a, std::wstring_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i] && FoldCase(a[i]) != FoldCase(b[i])) return false;
+    }
+    return true;
+}
+
+std::wstring ProcessIndex::Widen(std::string_view utf8) {
+    if (utf8.empty()) return std::wstring();
+    int length = MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), nullptr, 0);
+    if (length <= 0) return std::wstring();
+
+    std::wstring result(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, utf8.data(), static_cast<int>(utf8.size()), result.data(), length);
+    return result;
+}
+
+HANDLE ProcessIndex::CreateModuleSnapshot(DWORD pid) {
+    HANDLE snapshot;
+    int attempts = 0;
+    do {
+        snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, pid);
+    } while (snapshot == INVALID_HANDLE_VALUE && GetLastError() == ERROR_BAD_LENGTH && ++attempts < SnapshotRetries);
+    return snapshot;
+}
+
+bool ProcessIndex::Refresh(Changes* changes) {
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) return false;
+
+    std::vector<ProcessEntry> found;
+    found.reserve(entries.size() + 16);
+    std::vector<bool> kept(entries.size(), false);
+
+    PROCESSENTRY32W entry;
+    entry.dwSize = sizeof(PROCESSENTRY32W);
+    if (Process32FirstW(snapshot, &entry)) {
+        do {
+            // A reused PID shows up with a different parent or image name and counts as a new process
+            auto known = byPid.find(entry.th32ProcessID);
+            if (known != byPid.end() && !kept[known->second]) {
+                ProcessEntry& previous = entries[known->second];
+                if (previous.parentPid == entry.th32ParentProcessID && previous.name == entry.szExeFile) {
+                    kept[known->second] = true;
+                    previous.threads = entry.cntThreads;
+                    found.push_back(std::move(previous));
+                    continue;
+                }
+            }
+
+            std::wstring name(entry.szExeFile);
+            uint64_t hash = HashName(name);
+            found.push_back({ entry.th32ProcessID, entry.th32ParentProcessID, entry.cntThreads, std::move(name), hash });
+            if (changes) changes->started.push_back(entry.th32ProcessID);
+        } while (Process32NextW(snapshot, &entry));
+    }
+    CloseHandle(snapshot);
+
+    if (changes) {
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (!kept[i]) changes->exited.push_back(entries[i].pid);
+        }
+    }
+
+    entries = std::move(found);
+    byPid.clear();
+    byName.clear();
+    byPid.reserve(entries.size());
+    byName.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        byPid.emplace(entries[i].pid, i);
+        byName.emplace(entries[i].nameHash, i);
+    }
+    refreshed = Clock::now();
+    return true;
+}
+
+bool ProcessIndex::RefreshIfOlderThan(std::chrono::milliseconds age, Changes* changes) {
+    if (refreshed != Clock::time_point() && Clock::now() - refreshed < age) return true;
+    return Refresh(changes);
+}
+
+// Matches in snapshot order, so Find agrees with the first entry of FindAll
+std::vector<DWORD> ProcessIndex::FindAll(std::wstring_view name) const {
+    std::vector<size_t> matches;
+    auto [first, last] = byName.equal_range(HashName(name));
+    for (; first != last; ++first) {
+        if (NamesEqual(entries[first->second].name, name)) matches.push_back(first->second);
+    }
+    std::sort(matches.begin(), matches.end());
+
+    std::vector<DWORD> result;
+    result.reserve(matches.size());
+    for (size_t index : matches) result.push_back(entries[index].pid);
+    return result;
+}
+
+std::optional<DWORD> ProcessIndex::Find(std::wstring_view name) const {
+    std::optional<size_t> best;
+    auto [first, last] = byName.equal_range(HashName(name));
+    for (; first != last; ++first) {
+        if (NamesEqual(entries[first->second].name, name) && (!best || first->second < *best)) best = first->second;
+    }
+    return best ? std::optional<DWORD>(entries[*best].pid) : std::nullopt;
+}
+
+std::vector<DWORD> ProcessIndex::FindByModule(std::wstring_view moduleName, std::wstring_view processName) const {
+    std::vector<DWORD> candidates;
+    if (!processName.empty()) candidates = FindAll(processName);
+    else {
+        candidates.reserve(entries.size());
+        for (const ProcessEntry& entry : entries) candidates.push_back(entry.pid);
+    }
+
+    std::vector<DWORD> result;
+    for (DWORD pid : candidates) {
+        // A module snapshot of PID 0 would describe the calling process
+        if (pid == 0) continue;
+
+        HANDLE snapshot = CreateModuleSnapshot(pid);
+        if (snapshot == INVALID_HANDLE_VALUE) continue;
+
+        MODULEENTRY32W entry;
+        entry.dwSize = sizeof(MODULEENTRY32W);
+        bool loaded = false;
+        if (Module32FirstW(snapshot, &entry)) {
+            do {
+                loaded = NamesEqual(entry.szModule, moduleName);
+            } while (!loaded && Module32NextW(snapshot, &entry));
+        }
+        CloseHandle(snapshot);
+
+        if (loaded) result.push_back(pid);
+    }
+    return result;
+}
+
+std::vector<DWORD> ProcessIndex::FindByWindowTitle(std::wstring_view title) const {
+    struct Search {
+        std::wstring_view title;
+        std::vector<DWORD> pids;
+    } search{ title, {} };
+
+    EnumWindows([](HWND window, LPARAM param) -> BOOL {
+        Search& search = *reinterpret_cast<Search*>(param);
+        wchar_t text[512];
+        int length = GetWindowTextW(window, text, static_cast<int>(std::size(text)));
+        if (length > 0 && ContainsFolded(std::wstring_view(text, length), search.title)) {
+            DWORD pid = 0;
+            GetWindowThreadProcessId(window, &pid);
+            search.pids.push_back(pid);
+        }
+        return TRUE;
+    }, reinterpret_cast<LPARAM>(&search));
+
+    std::vector<size_t> matches;
+    for (DWORD pid : search.pids) {
+        auto known = byPid.find(pid);
+        if (known != byPid.end()) matches.push_back(known->second);
+    }
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+    std::vector<DWORD> result;
+    result.reserve(matches.size());
+    for (size_t index : matches) result.push_back(entries[index].pid);
+    return result;
+}
+
+const ProcessEntry* ProcessIndex::Get(DWORD pid) const {
+    auto it = byPid.find(pid);
+    return it != byPid.end() ? &entries[it->second] : nullptr;
+}
@@ -0,0 +1,73 @@
+#ifndef PROCESSINDEX_H
+#define PROCESSINDEX_H
+
+#include <windows.h>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct ProcessEntry {
+    DWORD pid;
+    DWORD parentPid;
+    DWORD threads;
+    std::wstring name;
+    uint64_t nameHash;
+};
+
+// Process list taken with one Toolhelp snapshot and searched by case-folded name hash.
+// Refresh takes a new snapshot but keeps the entries of processes that are still running,
+// so only started processes are converted and hashed.
+class ProcessIndex {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // CreateToolhelp32Snapshot fails with ERROR_BAD_LENGTH while the module list is changing; retried this often
+    static constexpr int SnapshotRetries = 8;
+
+    struct Changes {
+        std::vector<DWORD> started;
+        std::vector<DWORD> exited;
+    };
+
+    // FNV-1a over the name with ASCII and towlower case folding; equal for names that compare equal here
+    static uint64_t HashName(std::wstring_view name);
+    static bool NamesEqual(std::wstring_view a, std::wstring_view b);
+    static std::wstring Widen(std::string_view utf8);
+
+    // Toolhelp module snapshot of pid, retried on ERROR_BAD_LENGTH; INVALID_HANDLE_VALUE on failure
+    static HANDLE CreateModuleSnapshot(DWORD pid);
+
+    bool Refresh(Changes* changes = nullptr);
+    bool RefreshIfOlderThan(std::chrono::milliseconds age, Changes* changes = nullptr);
+
+    std::optional<DWORD> Find(std::wstring_view name) const;
+    std::optional<DWORD> Find(std::string_view name) const { return Find(Widen(name)); }
+    std::vector<DWORD> FindAll(std::wstring_view name) const;
+    std::vector<DWORD> FindAll(std::string_view name) const { return FindAll(Widen(name)); }
+
+    // Processes that have a module with this name loaded; one module snapshot per candidate, so narrow
+    // the candidates by processName where possible
+    std::vector<DWORD> FindByModule(std::wstring_view moduleName, std::wstring_view processName = {}) const;
+
+    // Indexed processes owning a top-level window whose title contains title, ignoring case; one EnumWindows pass
+    std::vector<DWORD> FindByWindowTitle(std::wstring_view title) const;
+
+    const ProcessEntry* Get(DWORD pid) const;
+    std::span<const ProcessEntry> Entries() const { return entries; }
+    size_t Size() const { return entries.size(); }
+    bool Empty() const { return entries.empty(); }
+    Clock::time_point Refreshed() const { return refreshed; }
+
+private:
+    std::vector<ProcessEntry> entries;
+    std::unordered_map<DWORD, size_t> byPid;
+    std::unordered_multimap<uint64_t, size_t> byName;
+    Clock::time_point refreshed;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "RegionMap.h"
+#include <algorithm>
+
+RegionMap::RegionMap(std::vector<MemoryRegion> regions, Clock::time_point verified)
+    : built(verified) {
+    std::sort(regions.begin(), regions.end(), [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+    entries.reserve(regions.size());
+    for (const MemoryRegion& region : regions) {
+        if (region.size != 0) entries.push_back({ region, verified });
+    }
+}
+
+size_t RegionMap::IndexOf(uintptr_t addr) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), addr, [](uintptr_t value, const Entry& entry) {
+        return value < entry.region.base;
+    });
+    if (it == entries.begin()) return entries.size();
+
+    --it;
+    return it->region.Contains(addr) ? static_cast<size_t>(it - entries.begin()) : entries.size();
+}
+
+const MemoryRegion* RegionMap::Find(uintptr_t addr) const {
+    size_t index = IndexOf(addr);
+    return index < entries.size() ? &entries[index].region : nullptr;
+}
+
+size_t RegionMap::ReadableLength(uintptr_t addr, size_t limit) const {
+    size_t index = IndexOf(addr);
+    size_t length = 0;
+    uintptr_t at = addr;
+    while (length < limit && index < entries.size() && entries[index].region.base <= at && entries[index].region.IsReadable()) {
+        const MemoryRegion& region = entries[index].region;
+        length = std::min(limit, static_cast<size_t>(region.End() - addr));
+        at = region.End();
+        index++;
+    }
+    return length;
+}
+
+bool RegionMap::IsReadable(uintptr_t addr, size_t size) const {
+    return size != 0 && ReadableLength(addr, size) == size;
+}
+
+RegionMap::Clock::time_point RegionMap::Verified(uintptr_t addr, size_t size) const {
+    // The walk runs to the top of user space, so nothing past the last entry can ever become mapped
+    if (!entries.empty() && addr >= entries.back().region.End()) return Clock::time_point::max();
+
+    size_t index = IndexOf(addr);
+    if (index == entries.size()) return built;
+
+    Clock::time_point oldest = entries[index].verified;
+    uintptr_t end = addr + size;
+    for (index++; index < entries.size() && entries[index].region.base < end; index++) {
+        oldest = std::min(oldest, entries[index].verified);
+    }
+    return oldest;
+}
+
+std::vector<MemoryRegion> RegionMap::Regions(uintptr_t start, uintptr_t end, bool readableOnly) const {
+    std::vector<MemoryRegion> result;
+    for (const Entry& entry : entries) {
+        if (entry.region.End() <= start) continue;
+        if (entry.region.base >= end) break;
+        if (!readableOnly || entry.region.IsReadable()) result.push_back(entry.region);
+    }
+    return result;
+}
+
+RegionMap RegionMap::Splice(uintptr_t start, uintptr_t end, std::span<const MemoryRegion> regions, Clock::time_point verified) const {
+    if (!regions.empty()) {
+        start = std::min(start, regions.front().base);
+        end = std::max(end, regions.back().End());
+    }
+
+    RegionMap result;
+    result.built = built;
+    result.entries.reserve(entries.size() + regions.size());
+
+    for (const Entry& entry : entries) {
+        if (entry.region.base >= start) break;
+        Entry kept = entry;
+        if (kept.region.End() > start) kept.region.size = start - kept.region.base;
+        result.entries.push_back(kept);
+    }
+
+    for (const MemoryRegion& region : regions) {
+        if (region.size != 0) result.entries.push_back({ region, verified });
+    }
+
+    for (const Entry& entry : entries) {
+        if (entry.region.End() <= end) continue;
+        Entry kept = entry;
+        if (kept.region.base < end) {
+            kept.region.size = kept.region.End() - end;
+            kept.region.base = end;
+        }
+        result.entries.push_back(kept);
+    }
+    return result;
+}
@@ -0,0 +1,72 @@
+#ifndef REGIONMAP_H
+#define REGIONMAP_H
+
+#include <windows.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct MemoryRegion {
+    uintptr_t base;
+    size_t size;
+    DWORD state;
+    DWORD protect;
+    DWORD type;
+
+    uintptr_t End() const { return base + size; }
+    bool Contains(uintptr_t addr) const { return addr >= base && addr < base + size; }
+
+    bool IsReadable() const {
+        return state == MEM_COMMIT && protect != 0 && !(protect & (PAGE_NOACCESS | PAGE_GUARD));
+    }
+
+    bool IsWritable() const {
+        return IsReadable() && (protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+    }
+
+    bool IsExecutable() const {
+        return IsReadable() && (protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY));
+    }
+};
+
+// Immutable, sorted snapshot of an address space; updates produce a new map
+class RegionMap {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RegionMap() = default;
+    RegionMap(std::vector<MemoryRegion> regions, Clock::time_point verified);
+
+    const MemoryRegion* Find(uintptr_t addr) const;
+    bool IsReadable(uintptr_t addr, size_t size) const;
+
+    // Oldest verification time of the entries covering the range; never expires past the last entry
+    Clock::time_point Verified(uintptr_t addr, size_t size) const;
+
+    // Readable stretch starting at addr, clamped to limit; 0 when addr is not readable
+    size_t ReadableLength(uintptr_t addr, size_t limit) const;
+
+    std::vector<MemoryRegion> Regions(uintptr_t start = 0, uintptr_t end = UINTPTR_MAX, bool readableOnly = true) const;
+
+    // Copy of this map with [start, end) replaced by fresh regions
+    RegionMap Splice(uintptr_t start, uintptr_t end, std::span<const MemoryRegion> regions, Clock::time_point verified) const;
+
+    size_t Size() const { return entries.size(); }
+    bool Empty() const { return entries.empty(); }
+    Clock::time_point Built() const { return built; }
+
+private:
+    struct Entry {
+        MemoryRegion region;
+        Clock::time_point verified;
+    };
+
+    size_t IndexOf(uintptr_t addr) const;
+
+    std::vector<Entry> entries;
+    Clock::time_point built;
+};
+
+#endif
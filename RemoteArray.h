@@ -0,0 +1,125 @@
+#ifndef REMOTEARRAY_H
+#define REMOTEARRAY_H
+
+#include "MemoryPhantom.h"
+#include <iterator>
+
+// Streams a large remote array chunk by chunk. Elements are `stride` bytes apart in the target
+// (sizeof(T) by default), so strided lists such as entity tables can be walked directly.
+template<typename T>
+class RemoteArray {
+    static_assert(std::is_trivially_copyable_v<T>, "RemoteArray requires a trivially copyable type");
+
+public:
+    static constexpr size_t DefaultChunkBytes = 256 * 1024;
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        Iterator() = default;
+        Iterator(RemoteArray* array, size_t index) : array(array), index(index) {}
+
+        T operator*() const { return array->Element(index); }
+
+        Iterator& operator++() {
+            index++;
+            if (index == array->chunkEnd && !array->Load(index)) index = array->count;
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        size_t Index() const { return index; }
+        uintptr_t Address() const { return array->addr + index * array->stride; }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+
+    private:
+        RemoteArray* array = nullptr;
+        size_t index = 0;
+    };
+
+    // Pooled buffer: borrowed from a per-thread free list and returned on destruction
+    RemoteArray(const MemoryPhantom& phantom, uintptr_t addr, size_t count, size_t stride = sizeof(T), size_t chunkBytes = DefaultChunkBytes)
+        : phantom(phantom), addr(addr), count(count), stride(stride ? stride : sizeof(T)), pooled(true) {
+        auto& pool = Pool();
+        if (!pool.empty()) {
+            owned = std::move(pool.back());
+            pool.pop_back();
+        }
+        owned.resize(std::max(chunkBytes, this->stride) / this->stride * this->stride);
+        buffer = owned;
+    }
+
+    // Caller-owned buffer, reused across calls without touching the heap
+    RemoteArray(const MemoryPhantom& phantom, uintptr_t addr, size_t count, std::span<uint8_t> buffer, size_t stride = sizeof(T))
+        : phantom(phantom), addr(addr), count(count), stride(stride ? stride : sizeof(T)), buffer(buffer), pooled(false) {}
+
+    ~RemoteArray() {
+        if (pooled) Pool().push_back(std::move(owned));
+    }
+
+    RemoteArray(const RemoteArray&) = delete;
+    RemoteArray& operator=(const RemoteArray&) = delete;
+
+    Iterator begin() {
+        available = count;
+        return Iterator(this, Load(0) ? 0 : count);
+    }
+
+    Iterator end() { return Iterator(this, count); }
+
+    size_t Size() const { return count; }
+
+    // True once iteration stopped early because a chunk could not be read
+    bool Failed() const { return available < count; }
+
+private:
+    const MemoryPhantom& phantom;
+    uintptr_t addr;
+    size_t count;
+    size_t stride;
+    std::vector<uint8_t> owned;
+    std::span<uint8_t> buffer;
+    bool pooled;
+
+    size_t chunkStart = 0;
+    size_t chunkEnd = 0;
+    size_t available = 0;
+
+    static std::vector<std::vector<uint8_t>>& Pool() {
+        thread_local std::vector<std::vector<uint8_t>> pool;
+        return pool;
+    }
+
+    bool Load(size_t index) {
+        const size_t perChunk = buffer.size() / stride;
+        if (index >= count || perChunk == 0) {
+            if (index < count) available = index;
+            return false;
+        }
+
+        size_t elements = std::min(perChunk, count - index);
+        size_t bytes = (elements - 1) * stride + sizeof(T);
+        size_t read = phantom.ReadArray<uint8_t>(addr + index * stride, bytes, buffer);
+        size_t complete = read >= sizeof(T) ? (read - sizeof(T)) / stride + 1 : 0;
+
+        chunkStart = index;
+        chunkEnd = index + std::min(elements, complete);
+        if (complete < elements) available = chunkEnd;
+        return chunkEnd > chunkStart;
+    }
+
+    T Element(size_t index) const {
+        T value;
+        memcpy(&value, buffer.data() + (index - chunkStart) * stride, sizeof(T));
+        return value;
+    }
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef SCANSESSION_H
+#define SCANSESSION_H
+
+#include "MemoryScanner.h"
+#include <bit>
+
+enum class ScanType {
+    Unknown,
+    Exact,
+    NotEqual,
+    Greater,
+    Less,
+    Changed,
+    Unchanged,
+    Increased,
+    Decreased,
+    IncreasedBy,
+    DecreasedBy
+};
+
+// Candidates are grouped per 4 KiB page: a page header plus 16-bit in-page offsets and the last value seen.
+// Pages where every slot is still a candidate ("dense") store no offsets at all.
+template<typename T>
+class ScanSession {
+    static_assert(std::is_arithmetic_v<T>, "ScanSession requires an arithmetic value type");
+
+public:
+    static constexpr size_t GroupPages = 256;
+    static constexpr size_t MaxRunPages = 64;
+
+    explicit ScanSession(const MemoryScanner& scanner, size_t alignment = alignof(T))
+        : scanner(scanner), alignment(std::clamp<size_t>(std::bit_floor(std::max<size_t>(alignment, 1)), 1, MemoryPhantom::PageSize)) {}
+
+    size_t FirstScan(ScanType type, const T& value = T(), const ScanOptions& options = ScanOptions()) {
+        Reset();
+        if (type != ScanType::Unknown && type != ScanType::Exact && type != ScanType::NotEqual &&
+            type != ScanType::Greater && type != ScanType::Less) {
+            return 0;
+        }
+
+        struct Chunk {
+            uintptr_t base;
+            size_t size;
+            size_t tail;
+        };
+
+        const size_t pageMask = MemoryPhantom::PageSize - 1;
+        const size_t chunkSize = (std::max(options.chunkSize, MemoryPhantom::PageSize) + pageMask) & ~pageMask;
+        std::vector<Chunk> chunks;
+        for (const MemoryRegion& region : scanner.Regions(options)) {
+            uintptr_t start = std::max(region.base, options.start) & ~static_cast<uintptr_t>(pageMask);
+            uintptr_t end = std::min(region.End(), options.end);
+            for (uintptr_t addr = start; addr < end; addr += chunkSize) {
+                size_t size = std::min(chunkSize, static_cast<size_t>(end - addr));
+                chunks.push_back({ addr, size, std::min(sizeof(T) - 1, static_cast<size_t>(end - addr - size)) });
+            }
+        }
+
+        std::vector<Candidates> outputs(chunks.size());
+        scanner.Pool().ParallelFor(chunks.size(), [&](size_t index) {
+            thread_local std::vector<uint8_t> buffer;
+            const Chunk& chunk = chunks[index];
+            buffer.resize(chunk.size + chunk.tail);
+
+            Dispatch(type, [&](auto tag) {
+                size_t got = ReadSpan(chunk.base, chunk.size, chunk.tail, buffer.data());
+                for (size_t offset = 0; offset < chunk.size; offset += MemoryPhantom::PageSize) {
+                    size_t available;
+                    const uint8_t* data;
+                    if (got) {
+                        data = buffer.data() + offset;
+                        available = got - offset;
+                    }
+                    else {
+                        size_t pageTail = offset + MemoryPhantom::PageSize < chunk.size ? sizeof(T) - 1 : chunk.tail;
+                        available = ReadSpan(chunk.base + offset, std::min(MemoryPhantom::PageSize, chunk.size - offset), pageTail, buffer.data());
+                        data = buffer.data();
+                    }
+                    if (available) EvaluateFirst<decltype(tag)::value>(chunk.base + offset, data, available, value, outputs[index]);
+                }
+            });
+        });
+
+        Merge(outputs);
+        return Count();
+    }
+
+    size_t NextScan(ScanType type, const T& value = T()) {
+        if (pages.empty() || type == ScanType::Unknown) return Count();
+
+        const size_t groups = (pages.size() + GroupPages - 1) / GroupPages;
+        std::vector<Candidates> outputs(groups);
+        scanner.Pool().ParallelFor(groups, [&](size_t group) {
+            thread_local std::vector<uint8_t> buffer;
+            buffer.resize(MaxRunPages * MemoryPhantom::PageSize + sizeof(T) - 1);
+
+            size_t last = std::min(pages.size(), (group + 1) * GroupPages);
+            Dispatch(type, [&](auto tag) {
+                for (size_t first = group * GroupPages; first < last;) {
+                    size_t end = first + 1;
+                    while (end < last && end - first < MaxRunPages && pages[end].base == pages[end - 1].base + MemoryPhantom::PageSize) end++;
+
+                    size_t got = ReadSpan(pages[first].base, (end - first) * MemoryPhantom::PageSize, sizeof(T) - 1, buffer.data());
+                    for (size_t page = first; page < end; page++) {
+                        size_t offset = (page - first) * MemoryPhantom::PageSize;
+                        if (got) {
+                            EvaluateNext<decltype(tag)::value>(pages[page], buffer.data() + offset, got - offset, value, outputs[group]);
+                        }
+                        else if (end - first > 1) {
+                            size_t available = ReadSpan(pages[page].base, MemoryPhantom::PageSize, sizeof(T) - 1, buffer.data());
+                            if (available) EvaluateNext<decltype(tag)::value>(pages[page], buffer.data(), available, value, outputs[group]);
+                        }
+                    }
+                    first = end;
+                }
+            });
+        });
+
+        Merge(outputs);
+        return Count();
+    }
+
+    size_t Count() const { return values.size(); }
+    size_t PageCount() const { return pages.size(); }
+
+    size_t MemoryUsage() const {
+        return pages.capacity() * sizeof(Page) + offsets.capacity() * sizeof(uint16_t) + values.capacity() * sizeof(T);
+    }
+
+    template<typename F>
+    void ForEach(F&& fn) const {
+        for (const Page& page : pages) {
+            for (size_t i = 0; i < page.count; i++) {
+                fn(page.base + SlotOffset(page, i), values[page.valueFirst + i]);
+            }
+        }
+    }
+
+    std::vector<uintptr_t> Addresses(size_t max = SIZE_MAX) const {
+        std::vector<uintptr_t> result;
+        result.reserve(std::min(max, Count()));
+        for (const Page& page : pages) {
+            for (size_t i = 0; i < page.count && result.size() < max; i++) {
+                result.push_back(page.base + SlotOffset(page, i));
+            }
+        }
+        return result;
+    }
+
+    void Reset() {
+        pages = std::vector<Page>();
+        offsets = std::vector<uint16_t>();
+        values = std::vector<T>();
+    }
+
+private:
+    struct Page {
+        uintptr_t base;
+        size_t valueFirst;
+        size_t offsetFirst;
+        uint16_t count;
+        bool dense;
+    };
+
+    struct Candidates {
+        std::vector<Page> pages;
+        std::vector<uint16_t> offsets;
+        std::vector<T> values;
+    };
+
+    const MemoryScanner& scanner;
+    const size_t alignment;
+    std::vector<Page> pages;
+    std::vector<uint16_t> offsets;
+    std::vector<T> values;
+
+    template<typename F>
+    static void Dispatch(ScanType type, F&& fn) {
+        switch (type) {
+        case ScanType::Unknown: fn(std::integral_constant<ScanType, ScanType::Unknown>()); break;
+        case ScanType::Exact: fn(std::integral_constant<ScanType, ScanType::Exact>()); break;
+        case ScanType::NotEqual: fn(std::integral_constant<ScanType, ScanType::NotEqual>()); break;
+        case ScanType::Greater: fn(std::integral_constant<ScanType, ScanType::Greater>()); break;
+        case ScanType::Less: fn(std::integral_constant<ScanType, ScanType::Less>()); break;
+        case ScanType::Changed: fn(std::integral_constant<ScanType, ScanType::Changed>()); break;
+        case ScanType::Unchanged: fn(std::integral_constant<ScanType, ScanType::Unchanged>()); break;
+        case ScanType::Increased: fn(std::integral_constant<ScanType, ScanType::Increased>()); break;
+        case ScanType::Decreased: fn(std::integral_constant<ScanType, ScanType::Decreased>()); break;
+        case ScanType::IncreasedBy: fn(std::integral_constant<ScanType, ScanType::IncreasedBy>()); break;
+        case ScanType::DecreasedBy: fn(std::integral_constant<ScanType, ScanType::DecreasedBy>()); break;
+        }
+    }
+
+    template<ScanType Type>
+    static bool Test(T current, T previous, T value) {
+        if constexpr (Type == ScanType::Unknown) return true;
+        else if constexpr (Type == ScanType::Exact) return current == value;
+        else if constexpr (Type == ScanType::NotEqual) return current != value;
+        else if constexpr (Type == ScanType::Greater) return current > value;
+        else if constexpr (Type == ScanType::Less) return current < value;
+        else if constexpr (Type == ScanType::Changed) return current != previous;
+        else if constexpr (Type == ScanType::Unchanged) return current == previous;
+        else if constexpr (Type == ScanType::Increased) return current > previous;
+        else if constexpr (Type == ScanType::Decreased) return current < previous;
+        else if constexpr (Type == ScanType::IncreasedBy) return static_cast<T>(current - previous) == value;
+        else return static_cast<T>(previous - current) == value;
+    }
+
+    size_t SlotOffset(const Page& page, size_t index) const {
+        return page.dense ? index * alignment : offsets[page.offsetFirst + index];
+    }
+
+    // Returns the number of bytes read: length + tail, length when the tail is unreadable, or 0
+    size_t ReadSpan(uintptr_t base, size_t length, size_t tail, uint8_t* buffer) const {
+        if (tail && scanner.ReadRaw(base, buffer, length + tail)) return length + tail;
+        return scanner.ReadRaw(base, buffer, length) ? length : 0;
+    }
+
+    template<ScanType Type>
+    void EvaluateFirst(uintptr_t base, const uint8_t* data, size_t available, const T& value, Candidates& out) const {
+        if (available < sizeof(T)) return;
+        const size_t slots = std::min(MemoryPhantom::PageSize / alignment, (available - sizeof(T)) / alignment + 1);
+
+        Page page{ base, out.values.size(), out.offsets.size(), 0, true };
+        for (size_t i = 0; i < slots; i++) {
+            T current;
+            memcpy(&current, data + i * alignment, sizeof(T));
+            if (Test<Type>(current, current, value)) {
+                out.offsets.push_back(static_cast<uint16_t>(i * alignment));
+                out.values.push_back(current);
+            }
+        }
+
+        page.count = static_cast<uint16_t>(out.values.size() - page.valueFirst);
+        if (page.count == 0) return;
+        if (page.count == slots) out.offsets.resize(page.offsetFirst);
+        else page.dense = false;
+        out.pages.push_back(page);
+    }
+
+    template<ScanType Type>
+    void EvaluateNext(const Page& page, const uint8_t* data, size_t available, const T& value, Candidates& out) const {
+        thread_local T current[MemoryPhantom::PageSize];
+        thread_local uint8_t keep[MemoryPhantom::PageSize];
+
+        const T* previous = values.data() + page.valueFirst;
+        size_t count = page.count;
+        if (page.dense) {
+            count = std::min(count, available >= sizeof(T) ? (available - sizeof(T)) / alignment + 1 : 0);
+            for (size_t i = 0; i < count; i++) memcpy(&current[i], data + i * alignment, sizeof(T));
+        }
+        else {
+            const uint16_t* slot = offsets.data() + page.offsetFirst;
+            while (count && slot[count - 1] + sizeof(T) > available) count--;
+            for (size_t i = 0; i < count; i++) memcpy(&current[i], data + slot[i], sizeof(T));
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            keep[i] = Test<Type>(current[i], previous[i], value);
+            kept += keep[i];
+        }
+        if (kept == 0) return;
+
+        Page result{ page.base, out.values.size(), out.offsets.size(), static_cast<uint16_t>(kept), page.dense && kept == page.count };
+        for (size_t i = 0; i < count; i++) {
+            if (!keep[i]) continue;
+            if (!result.dense) out.offsets.push_back(static_cast<uint16_t>(SlotOffset(page, i)));
+            out.values.push_back(current[i]);
+        }
+        out.pages.push_back(result);
+    }
+
+    void Merge(std::vector<Candidates>& outputs) {
+        size_t pageTotal = 0, offsetTotal = 0, valueTotal = 0;
+        for (const Candidates& output : outputs) {
+            pageTotal += output.pages.size();
+            offsetTotal += output.offsets.size();
+            valueTotal += output.values.size();
+        }
+
+        std::vector<Page> mergedPages;
+        std::vector<uint16_t> mergedOffsets;
+        std::vector<T> mergedValues;
+        mergedPages.reserve(pageTotal);
+        mergedOffsets.reserve(offsetTotal);
+        mergedValues.reserve(valueTotal);
+
+        for (Candidates& output : outputs) {
+            for (Page page : output.pages) {
+                page.valueFirst += mergedValues.size();
+                page.offsetFirst += mergedOffsets.size();
+                mergedPages.push_back(page);
+            }
+            mergedOffsets.insert(mergedOffsets.end(), output.offsets.begin(), output.offsets.end());
+            mergedValues.insert(mergedValues.end(), output.values.begin(), output.values.end());
+            output = Candidates();
+        }
+
+        pages = std::move(mergedPages);
+        offsets = std::move(mergedOffsets);
+        values = std::move(mergedValues);
+    }
+};
+
+#endif
@@ -0,0 +1,403 @@
+#include "Snapshot.h"
+#include "ChangeTracker.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(PHANTOM_SNAPSHOT_LZ4)
+#include <lz4.h>
+#endif
+
+namespace {
+    constexpr uint32_t SnapshotMagic = 0x4E534850; // "PHSN"
+    constexpr uint32_t SnapshotVersion = 1;
+    constexpr uint32_t PageTag = 0x45474150;       // "PAGE"
+    constexpr uint32_t FrameTag = 0x4D415246;      // "FRAM"
+    constexpr uint32_t PageCompressed = 1;
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t pageSize;
+        uint32_t reserved;
+    };
+
+    struct PageRecord {
+        uint32_t tag;
+        uint32_t storedSize;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    struct FrameRecord {
+        uint32_t tag;
+        uint32_t regionCount;
+        uint64_t pageCount;
+        int64_t time;
+    };
+
+    struct RegionRecord {
+        uint64_t base;
+        uint64_t size;
+        DWORD state;
+        DWORD protect;
+        DWORD type;
+        DWORD reserved;
+    };
+
+    struct PageEntry {
+        uint64_t addr;
+        uint64_t record;
+    };
+
+    template<typename T>
+    bool ReadStruct(const MappedFile& file, uint64_t offset, T& out) {
+        const uint8_t* at = file.At(offset, sizeof(T));
+        if (!at) return false;
+        memcpy(&out, at, sizeof(T));
+        return true;
+    }
+
+}
+
+std::unique_ptr<SnapshotWriter> SnapshotWriter::Create(const wchar_t* path, bool compress) {
+    if (!path) return nullptr;
+
+#if !defined(PHANTOM_SNAPSHOT_LZ4)
+    compress = false;
+#endif
+
+    HANDLE file = CreateFileW(path, GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    std::unique_ptr<SnapshotWriter> writer(new SnapshotWriter(file, compress));
+    FileHeader header{ SnapshotMagic, SnapshotVersion, static_cast<uint32_t>(MemoryPhantom::PageSize), 0 };
+    if (!writer->Append(&header, sizeof(header)) || !writer->Flush()) return nullptr;
+    return writer;
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    Flush();
+    CloseHandle(file);
+}
+
+bool SnapshotWriter::Append(const void* data, size_t size) {
+    if (failed) return false;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+    offset += size;
+    return buffer.size() < FlushThreshold || Flush();
+}
+
+bool SnapshotWriter::Flush() {
+    if (failed) return false;
+
+    size_t done = 0;
+    while (done < buffer.size()) {
+        DWORD written = 0;
+        DWORD request = static_cast<DWORD>(std::min<size_t>(buffer.size() - done, 0x40000000));
+        if (!WriteFile(file, buffer.data() + done, request, &written, nullptr) || written == 0) {
+            failed = true;
+            return false;
+        }
+        done += written;
+    }
+    stats.bytesWritten += buffer.size();
+    buffer.clear();
+    return true;
+}
+
+uint64_t SnapshotWriter::StorePage(const uint8_t* page) {
+    constexpr size_t pageSize = MemoryPhantom::PageSize;
+    uint64_t record = offset;
+
+#if defined(PHANTOM_SNAPSHOT_LZ4)
+    if (compress) {
+        packed.resize(LZ4_compressBound(static_cast<int>(pageSize)));
+        int size = LZ4_compress_default(reinterpret_cast<const char*>(page), reinterpret_cast<char*>(packed.data()),
+            static_cast<int>(pageSize), static_cast<int>(packed.size()));
+        if (size > 0 && static_cast<size_t>(size) < pageSize) {
+            PageRecord header{ PageTag, static_cast<uint32_t>(size), PageCompressed, 0 };
+            if (!Append(&header, sizeof(header)) || !Append(packed.data(), size)) return 0;
+            stats.storedPages++;
+            return record;
+        }
+    }
+#endif
+
+    PageRecord header{ PageTag, static_cast<uint32_t>(pageSize), 0, 0 };
+    if (!Append(&header, sizeof(header)) || !Append(page, pageSize)) return 0;
+    stats.storedPages++;
+    return record;
+}
+
+// 128 bits of key make an accidental match between different pages practically impossible, so a hit is
+// reused without reading the stored record back
+SnapshotWriter::PageKey SnapshotWriter::HashPage(const uint8_t* page) {
+    constexpr uint64_t highSeed = 0x9E3779B97F4A7C15ull;
+    return { ChangeTracker::Hash(page, MemoryPhantom::PageSize), ChangeTracker::Hash(page, MemoryPhantom::PageSize, highSeed) };
+}
+
+bool SnapshotWriter::Capture(const MemoryPhantom& phantom, uintptr_t start, uintptr_t end) {
+    std::vector<MemoryRegion> regions = phantom.QueryRegions(start, end, true);
+
+    // QueryRegions returns whole regions; keep only the requested part of the first and last
+    for (MemoryRegion& region : regions) {
+        uintptr_t base = std::max(region.base, start);
+        uintptr_t limit = std::min(region.End(), end);
+        region.base = base;
+        region.size = limit > base ? limit - base : 0;
+    }
+    regions.erase(std::remove_if(regions.begin(), regions.end(), [](const MemoryRegion& region) { return region.size == 0; }), regions.end());
+    return Capture(phantom, regions);
+}
+
+// Regions are read ChunkPages at a time; a chunk that fails is retried page by page
+bool SnapshotWriter::Capture(const MemoryPhantom& phantom, std::span<const MemoryRegion> regions) {
+    constexpr size_t pageSize = MemoryPhantom::PageSize;
+    if (failed) return false;
+
+    std::vector<PageEntry> pages;
+    chunk.resize(ChunkPages * pageSize);
+
+    for (const MemoryRegion& region : regions) {
+        uintptr_t page = region.base & ~static_cast<uintptr_t>(pageSize - 1);
+        uintptr_t end = region.End();
+
+        while (page < end) {
+            size_t count = std::min<size_t>(ChunkPages, (end - page + pageSize - 1) / pageSize);
+            bool whole = phantom.ReadBytes(page, std::span<uint8_t>(chunk.data(), count * pageSize));
+
+            for (size_t i = 0; i < count; i++) {
+                uintptr_t at = page + i * pageSize;
+                uint8_t* data = chunk.data() + i * pageSize;
+                stats.pages++;
+
+                if (!whole && !phantom.ReadBytes(at, std::span<uint8_t>(data, pageSize))) {
+                    stats.unreadablePages++;
+                    continue;
+                }
+
+                size_t low = static_cast<size_t>(std::max(region.base, at) - at);
+                size_t high = static_cast<size_t>(std::min<uintptr_t>(end, at + pageSize) - at);
+                if (low > 0) memset(data, 0, low);
+                if (high < pageSize) memset(data + high, 0, pageSize - high);
+
+                PageKey key = HashPage(data);
+                uint64_t record;
+                if (auto it = current.find(key); it != current.end()) {
+                    record = it->second;
+                    stats.dedupedPages++;
+                }
+                else if (auto old = previous.find(key); old != previous.end()) {
+                    record = old->second;
+                    current.emplace(key, record);
+                    stats.dedupedPages++;
+                }
+                else {
+                    record = StorePage(data);
+                    if (record == 0) return false;
+                    current.emplace(key, record);
+                }
+                pages.push_back({ at, record });
+            }
+            page += count * pageSize;
+        }
+    }
+
+    int64_t time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    FrameRecord frame{ FrameTag, static_cast<uint32_t>(regions.size()), pages.size(), time };
+    if (!Append(&frame, sizeof(frame))) return false;
+
+    for (const MemoryRegion& region : regions) {
+        RegionRecord record{ region.base, region.size, region.state, region.protect, region.type, 0 };
+        if (!Append(&record, sizeof(record))) return false;
+    }
+    if (!pages.empty() && !Append(pages.data(), pages.size() * sizeof(PageEntry))) return false;
+
+    previous.swap(current);
+    current.clear();
+    stats.frames++;
+    return Flush();
+}
+
+std::shared_ptr<SnapshotReader> SnapshotReader::Open(const wchar_t* path) {
+    auto file = MappedFile::Open(path);
+    if (!file) return nullptr;
+
+    std::shared_ptr<SnapshotReader> reader(new SnapshotReader(std::move(file)));
+    if (!reader->Parse()) return nullptr;
+    return reader;
+}
+
+// A truncated trailing record, e.g. from a writer that was killed mid-capture, ends parsing without failing it
+bool SnapshotReader::Parse() {
+    FileHeader header;
+    if (!ReadStruct(*file, 0, header) || header.magic != SnapshotMagic || header.version != SnapshotVersion) return false;
+    if (header.pageSize == 0 || (header.pageSize & (header.pageSize - 1)) != 0 || header.pageSize > 1024 * 1024) return false;
+    pageSize = header.pageSize;
+
+    auto validPage = [this](uint64_t record) {
+        PageRecord page;
+        if (!ReadStruct(*file, record, page) || page.tag != PageTag) return false;
+        if (page.flags & PageCompressed ? page.storedSize >= pageSize : page.storedSize != pageSize) return false;
+        return file->At(record + sizeof(page), page.storedSize) != nullptr;
+    };
+
+    uint64_t at = sizeof(header);
+    uint32_t tag;
+    while (ReadStruct(*file, at, tag)) {
+        if (tag == PageTag) {
+            PageRecord page;
+            if (!ReadStruct(*file, at, page) || !file->At(at + sizeof(page), page.storedSize)) break;
+            at += sizeof(page) + page.storedSize;
+        }
+        else if (tag == FrameTag) {
+            FrameRecord record;
+            if (!ReadStruct(*file, at, record) || record.pageCount > file->Size() / sizeof(PageEntry)) break;
+
+            uint64_t regionBytes = static_cast<uint64_t>(record.regionCount) * sizeof(RegionRecord);
+            uint64_t pageBytes = record.pageCount * sizeof(PageEntry);
+            const uint8_t* body = file->At(at + sizeof(record), regionBytes + pageBytes);
+            if (!body) break;
+
+            FrameInfo frame;
+            frame.time = record.time;
+            frame.regions.reserve(record.regionCount);
+            for (uint32_t r = 0; r < record.regionCount; r++) {
+                RegionRecord region;
+                memcpy(&region, body + r * sizeof(RegionRecord), sizeof(region));
+                frame.regions.push_back({ static_cast<uintptr_t>(region.base), static_cast<size_t>(region.size), region.state, region.protect, region.type });
+            }
+
+            frame.pages.reserve(static_cast<size_t>(record.pageCount));
+            for (uint64_t p = 0; p < record.pageCount; p++) {
+                PageEntry entry;
+                memcpy(&entry, body + regionBytes + p * sizeof(PageEntry), sizeof(entry));
+                if (entry.record >= at || !validPage(entry.record)) continue;
+                frame.pages.push_back({ static_cast<uintptr_t>(entry.addr), entry.record });
+            }
+
+            std::sort(frame.regions.begin(), frame.regions.end(), [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+            std::stable_sort(frame.pages.begin(), frame.pages.end(), [](const Page& a, const Page& b) { return a.addr < b.addr; });
+            frame.pages.erase(std::unique(frame.pages.begin(), frame.pages.end(), [](const Page& a, const Page& b) { return a.addr == b.addr; }), frame.pages.end());
+
+            frames.push_back(std::move(frame));
+            at += sizeof(record) + regionBytes + pageBytes;
+        }
+        else {
+            break;
+        }
+    }
+    return true;
+}
+
+std::chrono::system_clock::time_point SnapshotReader::FrameTime(size_t frame) const {
+    if (frame >= frames.size()) return {};
+    return std::chrono::system_clock::time_point(std::chrono::milliseconds(frames[frame].time));
+}
+
+std::shared_ptr<SnapshotFrame> SnapshotReader::Frame(size_t frame) const {
+    if (frame >= frames.size()) return nullptr;
+    return std::shared_ptr<SnapshotFrame>(new SnapshotFrame(shared_from_this(), frame));
+}
+
+const SnapshotReader::Page* SnapshotReader::FindPage(const FrameInfo& frame, uintptr_t page) const {
+    auto it = std::lower_bound(frame.pages.begin(), frame.pages.end(), page, [](const Page& entry, uintptr_t value) { return entry.addr < value; });
+    return it != frame.pages.end() && it->addr == page ? &*it : nullptr;
+}
+
+const uint8_t* SnapshotReader::PageData(uint64_t record, uint8_t* scratch) const {
+    PageRecord page;
+    memcpy(&page, file->Data() + record, sizeof(page));
+    const uint8_t* data = file->Data() + record + sizeof(page);
+    if (!(page.flags & PageCompressed)) return data;
+    if (!scratch) return nullptr;
+
+#if defined(PHANTOM_SNAPSHOT_LZ4)
+    int size = LZ4_decompress_safe(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(scratch),
+        static_cast<int>(page.storedSize), static_cast<int>(pageSize));
+    return size == static_cast<int>(pageSize) ? scratch : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+std::vector<SnapshotRange> SnapshotReader::Changes(size_t from, size_t to) const {
+    std::vector<SnapshotRange> result;
+    if (from >= frames.size() || to >= frames.size()) return result;
+
+    auto mark = [&](uintptr_t page) {
+        if (!result.empty() && result.back().End() == page) result.back().size += pageSize;
+        else result.push_back({ page, pageSize });
+    };
+
+    // Equal content shares a record unless it was stored again after dropping out of the dedup window
+    std::vector<uint8_t> left(pageSize), right(pageSize);
+    auto same = [&](uint64_t a, uint64_t b) {
+        if (a == b) return true;
+        const uint8_t* first = PageData(a, left.data());
+        const uint8_t* second = PageData(b, right.data());
+        return first && second && memcmp(first, second, pageSize) == 0;
+    };
+
+    const std::vector<Page>& a = frames[from].pages;
+    const std::vector<Page>& b = frames[to].pages;
+    size_t i = 0, j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (j == b.size() || (i < a.size() && a[i].addr < b[j].addr)) {
+            mark(a[i++].addr);
+        }
+        else if (i == a.size() || b[j].addr < a[i].addr) {
+            mark(b[j++].addr);
+        }
+        else {
+            if (!same(a[i].record, b[j].record)) mark(a[i].addr);
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+bool SnapshotFrame::Read(uintptr_t addr, void* buffer, size_t size) const {
+    const SnapshotReader::FrameInfo& frame = reader->frames[index];
+    const size_t pageSize = reader->pageSize;
+    thread_local std::vector<uint8_t> scratch;
+    if (scratch.size() < pageSize) scratch.resize(pageSize);
+
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    uintptr_t at = addr;
+    size_t remaining = size;
+    const SnapshotReader::Page* page = remaining > 0 ? reader->FindPage(frame, at & ~static_cast<uintptr_t>(pageSize - 1)) : nullptr;
+
+    while (remaining > 0) {
+        uintptr_t base = at & ~static_cast<uintptr_t>(pageSize - 1);
+        if (!page || page == frame.pages.data() + frame.pages.size() || page->addr != base) return false;
+
+        const uint8_t* data = reader->PageData(page->record, scratch.data());
+        if (!data) return false;
+
+        size_t take = std::min(remaining, pageSize - static_cast<size_t>(at - base));
+        memcpy(out, data + (at - base), take);
+        out += take;
+        at += take;
+        remaining -= take;
+        ++page;
+    }
+    return true;
+}
+
+// Only ranges inside a single uncompressed page are directly addressable
+std::span<const uint8_t> SnapshotFrame::View(uintptr_t addr, size_t size) const {
+    const size_t pageSize = reader->pageSize;
+    uintptr_t base = addr & ~static_cast<uintptr_t>(pageSize - 1);
+    if (size == 0 || size > pageSize - (addr - base)) return {};
+
+    const SnapshotReader::Page* page = reader->FindPage(reader->frames[index], base);
+    if (!page) return {};
+
+    const uint8_t* data = reader->PageData(page->record, nullptr);
+    if (!data) return {};
+    return std::span<const uint8_t>(data + (addr - base), size);
+}
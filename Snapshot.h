@@ -0,0 +1,144 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "MemoryPhantom.h"
+#include <unordered_map>
+
+// Snapshot files are an append-only stream of page records and frame records. Each Capture writes the pages
+// that changed since the previous frame, then a frame record holding the region metadata and a page table
+// that points back at page records anywhere earlier in the file.
+// Compression needs PHANTOM_SNAPSHOT_LZ4 defined and lz4 linked; without it pages are stored raw.
+
+struct SnapshotRange {
+    uintptr_t base;
+    size_t size;
+
+    uintptr_t End() const { return base + size; }
+};
+
+class SnapshotWriter {
+public:
+    static constexpr size_t ChunkPages = 64;
+    static constexpr size_t FlushThreshold = 1024 * 1024;
+
+    struct Stats {
+        uint64_t frames;
+        uint64_t pages;
+        uint64_t storedPages;
+        uint64_t dedupedPages;
+        uint64_t unreadablePages;
+        uint64_t bytesWritten;
+    };
+
+    static std::unique_ptr<SnapshotWriter> Create(const wchar_t* path, bool compress = false);
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Captures every page of the given regions as one frame; pages that cannot be read are left out.
+    // Bytes of a partial first or last page that lie outside its region are stored as zeros.
+    bool Capture(const MemoryPhantom& phantom, std::span<const MemoryRegion> regions);
+    // Regions are clipped to [start, end)
+    bool Capture(const MemoryPhantom& phantom, uintptr_t start = 0, uintptr_t end = UINTPTR_MAX);
+
+    bool Flush();
+
+    const Stats& GetStats() const { return stats; }
+    bool IsCompressed() const { return compress; }
+
+private:
+    SnapshotWriter(HANDLE file, bool compress) : file(file), compress(compress) {}
+
+    // Two XXH64 hashes with different seeds; pages with equal keys are treated as identical
+    struct PageKey {
+        uint64_t low;
+        uint64_t high;
+
+        bool operator==(const PageKey&) const = default;
+    };
+
+    struct PageKeyHash {
+        size_t operator()(const PageKey& key) const { return static_cast<size_t>(key.low); }
+    };
+
+    static PageKey HashPage(const uint8_t* page);
+    uint64_t StorePage(const uint8_t* page);
+    bool Append(const void* data, size_t size);
+
+    HANDLE file;
+    bool compress;
+    bool failed = false;
+    uint64_t offset = 0;
+    std::vector<uint8_t> buffer;
+    std::vector<uint8_t> chunk;
+    std::vector<uint8_t> packed;
+
+    // Content key -> page record, for the pages referenced by the previous and the current frame
+    std::unordered_map<PageKey, uint64_t, PageKeyHash> previous;
+    std::unordered_map<PageKey, uint64_t, PageKeyHash> current;
+
+    Stats stats{};
+};
+
+class SnapshotFrame;
+
+class SnapshotReader : public std::enable_shared_from_this<SnapshotReader> {
+public:
+    static std::shared_ptr<SnapshotReader> Open(const wchar_t* path);
+
+    size_t FrameCount() const { return frames.size(); }
+    std::chrono::system_clock::time_point FrameTime(size_t frame) const;
+
+    // Backend over one captured frame; keeps the reader alive
+    std::shared_ptr<SnapshotFrame> Frame(size_t frame) const;
+
+    // Page-granular ranges whose contents differ between two frames, including pages captured in only one
+    std::vector<SnapshotRange> Changes(size_t from, size_t to) const;
+
+private:
+    friend class SnapshotFrame;
+
+    struct Page {
+        uintptr_t addr;
+        uint64_t record;
+    };
+
+    struct FrameInfo {
+        int64_t time;
+        std::vector<MemoryRegion> regions;
+        std::vector<Page> pages;
+    };
+
+    explicit SnapshotReader(std::unique_ptr<MappedFile> file) : file(std::move(file)) {}
+
+    bool Parse();
+    const Page* FindPage(const FrameInfo& frame, uintptr_t page) const;
+
+    // Pointer to the page contents; compressed pages are expanded into scratch, which must hold pageSize bytes, or fail when it is null
+    const uint8_t* PageData(uint64_t record, uint8_t* scratch) const;
+
+    std::unique_ptr<MappedFile> file;
+    size_t pageSize = 0;
+    std::vector<FrameInfo> frames;
+};
+
+class SnapshotFrame : public MemoryBackend {
+public:
+    bool Read(uintptr_t addr, void* buffer, size_t size) const override;
+    std::span<const uint8_t> View(uintptr_t addr, size_t size) const override;
+    std::vector<MemoryRegion> Regions() const override { return reader->frames[index].regions; }
+
+    size_t Index() const { return index; }
+    std::chrono::system_clock::time_point Time() const { return reader->FrameTime(index); }
+
+private:
+    friend class SnapshotReader;
+
+    SnapshotFrame(std::shared_ptr<const SnapshotReader> reader, size_t index) : reader(std::move(reader)), index(index) {}
+
+    std::shared_ptr<const SnapshotReader> reader;
+    size_t index;
+};
+
+#endif
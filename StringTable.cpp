@@ -0,0 +1,167 @@
+#include "StringTable.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHANTOM_STRING_SSE2
+#endif
+
+namespace {
+    inline char* EncodeUnit(const char16_t* in, size_t count, size_t& i, char* out) {
+        uint32_t c = in[i++];
+        if (c < 0x80) {
+            *out++ = static_cast<char>(c);
+            return out;
+        }
+        if (c < 0x800) {
+            *out++ = static_cast<char>(0xC0 | (c >> 6));
+            *out++ = static_cast<char>(0x80 | (c & 0x3F));
+            return out;
+        }
+        if (c >= 0xD800 && c <= 0xDBFF && i < count && in[i] >= 0xDC00 && in[i] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (in[i++] - 0xDC00);
+            *out++ = static_cast<char>(0xF0 | (c >> 18));
+            *out++ = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+            *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+            *out++ = static_cast<char>(0x80 | (c & 0x3F));
+            return out;
+        }
+        if (c >= 0xD800 && c <= 0xDFFF) c = 0xFFFD;
+        *out++ = static_cast<char>(0xE0 | (c >> 12));
+        *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+        return out;
+    }
+}
+
+size_t StringTable::Utf16ToUtf8(std::span<const char16_t> units, char* out) {
+    const char16_t* in = units.data();
+    const size_t count = units.size();
+    char* start = out;
+    size_t i = 0;
+
+#if defined(PHANTOM_STRING_SSE2)
+    // Blocks of 8 ASCII units are narrowed with one pack; other blocks go through the scalar encoder
+    const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    while (i + 8 <= count) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, nonAscii), _mm_setzero_si128())) == 0xFFFF) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(block, block));
+            i += 8;
+            out += 8;
+            continue;
+        }
+        size_t blockEnd = i + 8;
+        while (i < blockEnd) out = EncodeUnit(in, count, i, out);
+    }
+#endif
+
+    while (i < count) out = EncodeUnit(in, count, i, out);
+    return static_cast<size_t>(out - start);
+}
+
+size_t StringTable::Read(const MemoryPhantom& phantom, std::span<const uintptr_t> pointers, size_t maxLength) {
+    slots.resize(pointers.size());
+    units.resize(pointers.size() * maxLength);
+    pending.clear();
+    for (size_t i = 0; i < pointers.size(); i++) {
+        slots[i] = { i * maxLength, 0, pointers[i], 0, 0, false };
+        if (pointers[i] != 0 && maxLength != 0) pending.push_back(i);
+    }
+
+    // Every pass reads the pending strings up to the next page end; only strings that ran into one take another pass
+    while (!pending.empty()) {
+        batch.Clear();
+        for (size_t index : pending) {
+            Slot& slot = slots[index];
+            size_t remaining = (maxLength - slot.units) * sizeof(char16_t);
+            size_t toPageEnd = (MemoryPhantom::PageSize - (slot.next & (MemoryPhantom::PageSize - 1))) & ~size_t(1);
+            size_t size = std::min(remaining, std::max(toPageEnd, sizeof(char16_t)));
+            batch.AddBytes(slot.next, units.data() + slot.unitOffset + slot.units, size);
+        }
+        phantom.Execute(batch);
+
+        size_t kept = 0;
+        std::span<const ReadRequest> requests = batch.Requests();
+        for (size_t i = 0; i < pending.size(); i++) {
+            Slot& slot = slots[pending[i]];
+            if (!requests[i].success) {
+                slot.success = slot.units > 0;
+                continue;
+            }
+
+            const char16_t* chunk = units.data() + slot.unitOffset + slot.units;
+            size_t count = requests[i].size / sizeof(char16_t);
+            const char16_t* terminator = std::find(chunk, chunk + count, u'\0');
+            slot.units += static_cast<size_t>(terminator - chunk);
+            if (terminator != chunk + count || slot.units == maxLength) {
+                slot.success = true;
+                continue;
+            }
+            slot.next += requests[i].size;
+            pending[kept++] = pending[i];
+        }
+        pending.resize(kept);
+    }
+
+    return Transcode();
+}
+
+size_t StringTable::Read(const MemoryPhantom& phantom, std::span<const RemoteString> strings) {
+    size_t total = 0;
+    for (const RemoteString& string : strings) total += string.length;
+
+    slots.resize(strings.size());
+    units.resize(total);
+    pending.clear();
+    batch.Clear();
+
+    size_t unitOffset = 0;
+    for (size_t i = 0; i < strings.size(); i++) {
+        const RemoteString& string = strings[i];
+        slots[i] = { unitOffset, string.length, string.addr, 0, 0, string.length == 0 };
+        if (string.length != 0) {
+            batch.AddBytes(string.addr, units.data() + unitOffset, string.length * sizeof(char16_t));
+            pending.push_back(i);
+        }
+        unitOffset += string.length;
+    }
+
+    if (!pending.empty()) phantom.Execute(batch);
+    for (size_t i = 0; i < pending.size(); i++) {
+        Slot& slot = slots[pending[i]];
+        slot.success = batch.Succeeded(i);
+        if (!slot.success) slot.units = 0;
+    }
+
+    return Transcode();
+}
+
+size_t StringTable::Transcode() {
+    size_t needed = 0;
+    for (const Slot& slot : slots) needed += MaxUtf8Size(slot.units);
+    if (needed > arenaCapacity) {
+        arena = std::make_unique_for_overwrite<char[]>(needed);
+        arenaCapacity = needed;
+    }
+
+    size_t succeeded = 0;
+    arenaSize = 0;
+    for (Slot& slot : slots) {
+        slot.offset = arenaSize;
+        slot.length = slot.success ? Utf16ToUtf8(std::span<const char16_t>(units.data() + slot.unitOffset, slot.units), arena.get() + arenaSize) : 0;
+        arenaSize += slot.length;
+        succeeded += slot.success;
+    }
+    return succeeded;
+}
+
+void StringTable::Clear() {
+    slots.clear();
+    arenaSize = 0;
+}
@@ -0,0 +1,69 @@
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+#include "MemoryPhantom.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// A counted remote UTF-16 string, e.g. the Buffer and Length / 2 of a UNICODE_STRING
+struct RemoteString {
+    uintptr_t addr;
+    size_t length;
+};
+
+// Reads many remote UTF-16 strings with coalesced batch reads and transcodes them into one UTF-8 arena.
+// Views stay valid until the next Read or Clear. Buffers are kept between calls, so a table refilled
+// every tick stops allocating once it has seen its largest set.
+class StringTable {
+public:
+    static constexpr size_t DefaultMaxLength = 256;
+
+    // Null-terminated strings of up to maxLength units each; returns how many succeeded.
+    // Reads stop at page ends, so a short string next to an unreadable page still arrives,
+    // and a string that fails partway keeps the units read before the failure.
+    size_t Read(const MemoryPhantom& phantom, std::span<const uintptr_t> pointers, size_t maxLength = DefaultMaxLength);
+    // Exactly length units per string, embedded nulls included
+    size_t Read(const MemoryPhantom& phantom, std::span<const RemoteString> strings);
+
+    // Empty for failed entries
+    std::string_view operator[](size_t index) const {
+        const Slot& slot = slots[index];
+        return std::string_view(arena.get() + slot.offset, slot.length);
+    }
+
+    bool Succeeded(size_t index) const { return index < slots.size() && slots[index].success; }
+    size_t Size() const { return slots.size(); }
+    bool Empty() const { return slots.empty(); }
+    size_t ArenaSize() const { return arenaSize; }
+    void Clear();
+
+    // Unpaired surrogates become U+FFFD; out needs MaxUtf8Size(units.size()) bytes
+    static constexpr size_t MaxUtf8Size(size_t units) { return units * 3; }
+    static size_t Utf16ToUtf8(std::span<const char16_t> units, char* out);
+
+private:
+    struct Slot {
+        size_t unitOffset;
+        size_t units;
+        uintptr_t next;
+        size_t offset;
+        size_t length;
+        bool success;
+    };
+
+    size_t Transcode();
+
+    ReadBatch batch;
+    std::vector<Slot> slots;
+    std::vector<char16_t> units;
+    std::vector<size_t> pending;
+    std::unique_ptr<char[]> arena;
+    size_t arenaCapacity = 0;
+    size_t arenaSize = 0;
+};
+
+#endif
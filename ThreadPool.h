@@ -0,0 +1,155 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount = 0) {
+        if (threadCount == 0) threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < threadCount; i++) {
+            threads.emplace_back([this, i] { Run(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t Size() const { return workers.size(); }
+
+    // Tasks submitted from a worker land on that worker's own queue; idle workers steal from the others
+    void Submit(std::function<void()> task) {
+        size_t target = CurrentWorker() == this ? CurrentIndex() : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+        {
+            std::lock_guard<std::mutex> lock(workers[target]->mutex);
+            workers[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            queued++;
+        }
+        wake.notify_one();
+    }
+
+    // Runs fn(0..count-1) across the pool and the calling thread, returns when every index has run
+    template<typename F>
+    void ParallelFor(size_t count, F&& fn) {
+        if (count == 0) return;
+
+        struct State {
+            std::atomic<size_t> next{ 0 };
+            std::atomic<size_t> done{ 0 };
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        auto state = std::make_shared<State>();
+
+        auto drain = [state, count, &fn] {
+            size_t completed = 0;
+            for (size_t index = state->next.fetch_add(1); index < count; index = state->next.fetch_add(1)) {
+                fn(index);
+                completed++;
+            }
+            if (completed && state->done.fetch_add(completed) + completed == count) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        };
+
+        size_t helpers = std::min(count, workers.size()) - (count <= workers.size() ? 1 : 0);
+        for (size_t i = 0; i < helpers; i++) Submit(drain);
+        drain();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&] { return state->done.load() == count; });
+    }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nextWorker{ 0 };
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    size_t queued = 0;
+    bool stopping = false;
+
+    static ThreadPool*& CurrentWorker() {
+        thread_local ThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t& CurrentIndex() {
+        thread_local size_t index = 0;
+        return index;
+    }
+
+    bool TryTake(size_t index, std::function<void()>& task) {
+        {
+            Worker& own = *workers[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < workers.size(); i++) {
+            Worker& victim = *workers[(index + i) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Run(size_t index) {
+        CurrentWorker() = this;
+        CurrentIndex() = index;
+
+        std::function<void()> task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wake.wait(lock, [this] { return stopping || queued > 0; });
+                if (queued == 0) return;
+                queued--;
+            }
+            while (!TryTake(index, task)) std::this_thread::yield();
+            task();
+            task = nullptr;
+        }
+    }
+};
+
+#endif
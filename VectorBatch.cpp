@@ -0,0 +1,202 @@
+#include "VectorBatch.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX__)
+#define PHANTOM_VECTOR_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHANTOM_VECTOR_SSE
+#endif
+
+namespace {
+#if defined(PHANTOM_VECTOR_AVX)
+    constexpr size_t Lanes = 8;
+    using Pack = __m256;
+
+    inline Pack Load(const float* p) { return _mm256_loadu_ps(p); }
+    inline void Store(float* p, Pack v) { _mm256_storeu_ps(p, v); }
+    inline Pack Splat(float v) { return _mm256_set1_ps(v); }
+    inline Pack Add(Pack a, Pack b) { return _mm256_add_ps(a, b); }
+    inline Pack Sub(Pack a, Pack b) { return _mm256_sub_ps(a, b); }
+    inline Pack Mul(Pack a, Pack b) { return _mm256_mul_ps(a, b); }
+    inline Pack Div(Pack a, Pack b) { return _mm256_div_ps(a, b); }
+    inline Pack Max(Pack a, Pack b) { return _mm256_max_ps(a, b); }
+    inline Pack Sqrt(Pack a) { return _mm256_sqrt_ps(a); }
+    inline unsigned AtLeast(Pack a, Pack b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ))); }
+
+    // Writes x0 y0 x1 y1 ... x7 y7
+    inline void StoreInterleaved(float* out, Pack xs, Pack ys) {
+        Pack low = _mm256_unpacklo_ps(xs, ys);
+        Pack high = _mm256_unpackhi_ps(xs, ys);
+        _mm256_storeu_ps(out, _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(low, high, 0x31));
+    }
+#elif defined(PHANTOM_VECTOR_SSE)
+    constexpr size_t Lanes = 4;
+    using Pack = __m128;
+
+    inline Pack Load(const float* p) { return _mm_loadu_ps(p); }
+    inline void Store(float* p, Pack v) { _mm_storeu_ps(p, v); }
+    inline Pack Splat(float v) { return _mm_set1_ps(v); }
+    inline Pack Add(Pack a, Pack b) { return _mm_add_ps(a, b); }
+    inline Pack Sub(Pack a, Pack b) { return _mm_sub_ps(a, b); }
+    inline Pack Mul(Pack a, Pack b) { return _mm_mul_ps(a, b); }
+    inline Pack Div(Pack a, Pack b) { return _mm_div_ps(a, b); }
+    inline Pack Max(Pack a, Pack b) { return _mm_max_ps(a, b); }
+    inline Pack Sqrt(Pack a) { return _mm_sqrt_ps(a); }
+    inline unsigned AtLeast(Pack a, Pack b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(a, b))); }
+
+    inline void StoreInterleaved(float* out, Pack xs, Pack ys) {
+        _mm_storeu_ps(out, _mm_unpacklo_ps(xs, ys));
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(xs, ys));
+    }
+#endif
+
+    // Row r of the projection as coefficients of x, y, z and 1
+    struct Projection {
+        float row[3][4];
+
+        Projection(std::span<const float, 16> m, MatrixLayout layout) {
+            static constexpr size_t rows[3] = { 0, 1, 3 };
+            for (size_t r = 0; r < 3; r++) {
+                for (size_t c = 0; c < 4; c++) {
+                    row[r][c] = layout == MatrixLayout::RowMajor ? m[rows[r] * 4 + c] : m[c * 4 + rows[r]];
+                }
+            }
+        }
+    };
+}
+
+void VectorBatch::Assign(std::span<const Vector3> points) {
+    x.resize(points.size());
+    y.resize(points.size());
+    z.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        x[i] = points[i].x;
+        y[i] = points[i].y;
+        z[i] = points[i].z;
+    }
+}
+
+void VectorBatch::AssignStrided(std::span<const uint8_t> records, size_t stride, size_t offset) {
+    size_t count = stride != 0 && offset + sizeof(Vector3) <= stride ? records.size() / stride : 0;
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+
+    for (size_t i = 0; i < count; i++) {
+        float point[3];
+        memcpy(point, records.data() + i * stride + offset, sizeof(point));
+        x[i] = point[0];
+        y[i] = point[1];
+        z[i] = point[2];
+    }
+}
+
+bool VectorBatch::DistancesSquared(const Vector3& origin, std::span<float> out) const {
+    if (out.size() < Size()) return false;
+
+    size_t i = 0;
+#if defined(PHANTOM_VECTOR_AVX) || defined(PHANTOM_VECTOR_SSE)
+    Pack ox = Splat(origin.x), oy = Splat(origin.y), oz = Splat(origin.z);
+    for (; i + Lanes <= Size(); i += Lanes) {
+        Pack dx = Sub(Load(&x[i]), ox);
+        Pack dy = Sub(Load(&y[i]), oy);
+        Pack dz = Sub(Load(&z[i]), oz);
+        Store(&out[i], Add(Add(Mul(dx, dx), Mul(dy, dy)), Mul(dz, dz)));
+    }
+#endif
+    for (; i < Size(); i++) {
+        float dx = x[i] - origin.x, dy = y[i] - origin.y, dz = z[i] - origin.z;
+        out[i] = dx * dx + dy * dy + dz * dz;
+    }
+    return true;
+}
+
+bool VectorBatch::Distances(const Vector3& origin, std::span<float> out) const {
+    if (!DistancesSquared(origin, out)) return false;
+
+    size_t i = 0;
+#if defined(PHANTOM_VECTOR_AVX) || defined(PHANTOM_VECTOR_SSE)
+    for (; i + Lanes <= Size(); i += Lanes) Store(&out[i], Sqrt(Load(&out[i])));
+#endif
+    for (; i < Size(); i++) out[i] = std::sqrt(out[i]);
+    return true;
+}
+
+size_t VectorBatch::Nearest(const Vector3& origin, std::span<uint32_t> out, float maxDistance) const {
+    if (out.empty() || Empty()) return 0;
+
+    thread_local std::vector<float> distances;
+    thread_local std::vector<uint32_t> candidates;
+    distances.resize(Size());
+    DistancesSquared(origin, distances);
+
+    float limit = maxDistance * maxDistance;
+    candidates.clear();
+    for (uint32_t i = 0; i < Size(); i++) {
+        if (distances[i] <= limit) candidates.push_back(i);
+    }
+
+    auto closer = [](uint32_t a, uint32_t b) { return distances[a] != distances[b] ? distances[a] < distances[b] : a < b; };
+    size_t count = std::min(out.size(), candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), closer);
+    std::copy_n(candidates.begin(), count, out.begin());
+    return count;
+}
+
+// Screen x = w/2 * (1 + clip.x / clip.w), screen y = h/2 * (1 - clip.y / clip.w)
+size_t VectorBatch::Project(std::span<const float, 16> matrix, MatrixLayout layout, float width, float height,
+    std::span<Vector2> out, std::span<uint8_t> visible) const {
+    if (out.size() < Size() || (!visible.empty() && visible.size() < Size())) return 0;
+
+    Projection p(matrix, layout);
+    float halfWidth = width * 0.5f, halfHeight = height * 0.5f;
+    size_t inFront = 0;
+
+    size_t i = 0;
+#if defined(PHANTOM_VECTOR_AVX) || defined(PHANTOM_VECTOR_SSE)
+    float* screen = reinterpret_cast<float*>(out.data());
+    Pack r[3][4];
+    for (size_t row = 0; row < 3; row++) {
+        for (size_t c = 0; c < 4; c++) r[row][c] = Splat(p.row[row][c]);
+    }
+    Pack hw = Splat(halfWidth), hh = Splat(halfHeight), minW = Splat(MinClipW);
+
+    for (; i + Lanes <= Size(); i += Lanes) {
+        Pack px = Load(&x[i]), py = Load(&y[i]), pz = Load(&z[i]);
+        Pack cx = Add(Add(Mul(r[0][0], px), Mul(r[0][1], py)), Add(Mul(r[0][2], pz), r[0][3]));
+        Pack cy = Add(Add(Mul(r[1][0], px), Mul(r[1][1], py)), Add(Mul(r[1][2], pz), r[1][3]));
+        Pack cw = Add(Add(Mul(r[2][0], px), Mul(r[2][1], py)), Add(Mul(r[2][2], pz), r[2][3]));
+
+        unsigned mask = AtLeast(cw, minW);
+        Pack scale = Div(Splat(1.0f), Max(cw, minW));
+        StoreInterleaved(screen + i * 2, Add(hw, Mul(Mul(hw, cx), scale)), Sub(hh, Mul(Mul(hh, cy), scale)));
+
+        inFront += std::popcount(mask);
+        if (!visible.empty()) {
+            for (size_t lane = 0; lane < Lanes; lane++) visible[i + lane] = (mask >> lane) & 1;
+        }
+    }
+#endif
+    for (; i < Size(); i++) {
+        float cx = p.row[0][0] * x[i] + p.row[0][1] * y[i] + p.row[0][2] * z[i] + p.row[0][3];
+        float cy = p.row[1][0] * x[i] + p.row[1][1] * y[i] + p.row[1][2] * z[i] + p.row[1][3];
+        float cw = p.row[2][0] * x[i] + p.row[2][1] * y[i] + p.row[2][2] * z[i] + p.row[2][3];
+
+        bool front = cw >= MinClipW;
+        float scale = 1.0f / std::max(cw, MinClipW);
+        out[i] = Vector2(halfWidth + halfWidth * cx * scale, halfHeight - halfHeight * cy * scale);
+
+        inFront += front;
+        if (!visible.empty()) visible[i] = front;
+    }
+    return inFront;
+}
@@ -0,0 +1,69 @@
+#ifndef VECTORBATCH_H
+#define VECTORBATCH_H
+
+#include "Vectors.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+// RowMajor: clip.x = m[0]*x + m[1]*y + m[2]*z + m[3], w from m[12..15] (Source 2)
+// ColumnMajor: clip.x = m[0]*x + m[4]*y + m[8]*z + m[12], w from m[3], m[7], m[11], m[15]
+enum class MatrixLayout {
+    RowMajor,
+    ColumnMajor
+};
+
+// Points stored as separate x/y/z arrays so the kernels process 8 (AVX) or 4 (SSE) points per instruction
+class VectorBatch {
+public:
+    static constexpr float MinClipW = 0.01f;
+
+    VectorBatch() = default;
+    explicit VectorBatch(std::span<const Vector3> points) { Assign(points); }
+
+    void Assign(std::span<const Vector3> points);
+
+    // Picks the Vector3 at `offset` out of each `stride`-byte record, e.g. an entity array fetched with one ReadArray
+    void AssignStrided(std::span<const uint8_t> records, size_t stride, size_t offset);
+
+    void Push(const Vector3& point) {
+        x.push_back(point.x);
+        y.push_back(point.y);
+        z.push_back(point.z);
+    }
+
+    void Clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    size_t Size() const { return x.size(); }
+    bool Empty() const { return x.empty(); }
+    Vector3 operator[](size_t index) const { return Vector3(x[index], y[index], z[index]); }
+
+    std::span<const float> X() const { return x; }
+    std::span<const float> Y() const { return y; }
+    std::span<const float> Z() const { return z; }
+
+    // The kernels return false without touching out when it is smaller than Size()
+    bool Distances(const Vector3& origin, std::span<float> out) const;
+    bool DistancesSquared(const Vector3& origin, std::span<float> out) const;
+
+    // Indices of up to out.size() points closest to origin that lie within maxDistance, closest first
+    size_t Nearest(const Vector3& origin, std::span<uint32_t> out, float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+    // World-to-screen for every point; returns how many are in front of the camera (clip w >= MinClipW).
+    // visible, when given, receives 1/0 per point; points behind the camera get undefined screen coordinates.
+    size_t Project(std::span<const float, 16> matrix, MatrixLayout layout, float width, float height,
+        std::span<Vector2> out, std::span<uint8_t> visible = {}) const;
+
+private:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+};
+
+#endif
@@ -1,27 +1,58 @@
 #ifndef VECTORS_H
 #define VECTORS_H
 
+#include <charconv>
 #include <cmath>
-#include <iostream>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+// Writes "(a, b, ...)" with fixed-point components into buffer and NUL-terminates it.
+// Returns the length written, or 0 (empty string) when the buffer is too small.
+inline size_t FormatComponents(char* buffer, size_t size, const float* values, size_t count, int precision) {
+    if (size == 0) return 0;
+
+    char* at = buffer;
+    char* end = buffer + size - 1;
+    auto put = [&](const char* text, size_t length) {
+        if (static_cast<size_t>(end - at) < length) return false;
+        for (size_t i = 0; i < length; i++) *at++ = text[i];
+        return true;
+    };
+
+    bool ok = put("(", 1);
+    for (size_t i = 0; ok && i < count; i++) {
+        if (i > 0) ok = put(", ", 2);
+        if (!ok) break;
+        auto result = std::to_chars(at, end, values[i], std::chars_format::fixed, precision);
+        ok = result.ec == std::errc();
+        if (ok) at = result.ptr;
+    }
+    ok = ok && put(")", 1);
+
+    if (!ok) at = buffer;
+    *at = '\0';
+    return static_cast<size_t>(at - buffer);
+}
 
 class Vector3 {
     public:
         float x, y, z;
 
-        Vector3() {
-            this->x = 0;
-            this->y = 0;
-            this->z = 0;
-        }
+        // Trivial, so `Vector3 v;` is uninitialized; `Vector3()` and `Vector3{}` are zero
+        Vector3() = default;
+        constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        static constexpr size_t MaxFormatLength = 160;
 
-        Vector3(float x, float y, float z){
-            this->x = x;
-            this->y = y;
-            this->z = z;
+        size_t Format(char* buffer, size_t size, int precision = 6) const {
+            const float values[3] = { x, y, z };
+            return FormatComponents(buffer, size, values, 3, precision);
         }
 
-        const std::string to_string() {
-            return "(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")";
+        std::string to_string() const {
+            char buffer[MaxFormatLength];
+            return std::string(buffer, Format(buffer, sizeof(buffer)));
         }
 
         static Vector3 Add(const Vector3& a, const Vector3& b) {
@@ -39,24 +70,58 @@ class Vector3 {
                 (b.z - a.z) * (b.z - a.z)
             );
         }
+
+        static constexpr float DistanceSquared(const Vector3& a, const Vector3& b) {
+            return (b - a).LengthSquared();
+        }
+
+        static constexpr float Dot(const Vector3& a, const Vector3& b) {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        static constexpr Vector3 Cross(const Vector3& a, const Vector3& b) {
+            return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+        }
+
+        constexpr float LengthSquared() const { return x * x + y * y + z * z; }
+        float Length() const { return std::sqrt(LengthSquared()); }
+
+        Vector3 Normalized() const {
+            float length = Length();
+            return length > 0 ? *this / length : Vector3();
+        }
+
+        constexpr Vector3 operator+(const Vector3& other) const { return Vector3(x + other.x, y + other.y, z + other.z); }
+        constexpr Vector3 operator-(const Vector3& other) const { return Vector3(x - other.x, y - other.y, z - other.z); }
+        constexpr Vector3 operator-() const { return Vector3(-x, -y, -z); }
+        constexpr Vector3 operator*(float scale) const { return Vector3(x * scale, y * scale, z * scale); }
+        constexpr Vector3 operator/(float scale) const { return Vector3(x / scale, y / scale, z / scale); }
+        constexpr Vector3& operator+=(const Vector3& other) { x += other.x; y += other.y; z += other.z; return *this; }
+        constexpr Vector3& operator-=(const Vector3& other) { x -= other.x; y -= other.y; z -= other.z; return *this; }
+        constexpr Vector3& operator*=(float scale) { x *= scale; y *= scale; z *= scale; return *this; }
+        constexpr Vector3& operator/=(float scale) { x /= scale; y /= scale; z /= scale; return *this; }
+        constexpr bool operator==(const Vector3& other) const { return x == other.x && y == other.y && z == other.z; }
+
+        friend constexpr Vector3 operator*(float scale, const Vector3& v) { return v * scale; }
 };
 
 class Vector2 {
     public:
         float x, y;
 
-        Vector2() {
-            this->x = 0;
-            this->y = 0;
-        }
+        Vector2() = default;
+        constexpr Vector2(float x, float y) : x(x), y(y) {}
+
+        static constexpr size_t MaxFormatLength = 112;
 
-        Vector2(float x, float y) {
-            this->x = x;
-            this->y = y;
+        size_t Format(char* buffer, size_t size, int precision = 6) const {
+            const float values[2] = { x, y };
+            return FormatComponents(buffer, size, values, 2, precision);
         }
 
         std::string to_string() const {
-            return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
+            char buffer[MaxFormatLength];
+            return std::string(buffer, Format(buffer, sizeof(buffer)));
         }
 
         static Vector2 Add(const Vector2& a, const Vector2& b) {
@@ -73,5 +138,42 @@ class Vector2 {
                 (b.y - a.y) * (b.y - a.y)
             );
         }
+
+        static constexpr float DistanceSquared(const Vector2& a, const Vector2& b) {
+            return (b - a).LengthSquared();
+        }
+
+        static constexpr float Dot(const Vector2& a, const Vector2& b) {
+            return a.x * b.x + a.y * b.y;
+        }
+
+        constexpr float LengthSquared() const { return x * x + y * y; }
+        float Length() const { return std::sqrt(LengthSquared()); }
+
+        Vector2 Normalized() const {
+            float length = Length();
+            return length > 0 ? *this / length : Vector2();
+        }
+
+        constexpr Vector2 operator+(const Vector2& other) const { return Vector2(x + other.x, y + other.y); }
+        constexpr Vector2 operator-(const Vector2& other) const { return Vector2(x - other.x, y - other.y); }
+        constexpr Vector2 operator-() const { return Vector2(-x, -y); }
+        constexpr Vector2 operator*(float scale) const { return Vector2(x * scale, y * scale); }
+        constexpr Vector2 operator/(float scale) const { return Vector2(x / scale, y / scale); }
+        constexpr Vector2& operator+=(const Vector2& other) { x += other.x; y += other.y; return *this; }
+        constexpr Vector2& operator-=(const Vector2& other) { x -= other.x; y -= other.y; return *this; }
+        constexpr Vector2& operator*=(float scale) { x *= scale; y *= scale; return *this; }
+        constexpr Vector2& operator/=(float scale) { x /= scale; y /= scale; return *this; }
+        constexpr bool operator==(const Vector2& other) const { return x == other.x && y == other.y; }
+
+        friend constexpr Vector2 operator*(float scale, const Vector2& v) { return v * scale; }
 };
+
+// Remote structs are read and written as raw bytes, so the layout must match the target's float[2] / float[3]
+static_assert(std::is_trivial_v<Vector2> && std::is_standard_layout_v<Vector2>, "Vector2 must stay trivial");
+static_assert(std::is_trivial_v<Vector3> && std::is_standard_layout_v<Vector3>, "Vector3 must stay trivial");
+static_assert(sizeof(Vector2) == 2 * sizeof(float) && alignof(Vector2) == alignof(float), "Vector2 must be two packed floats");
+static_assert(sizeof(Vector3) == 3 * sizeof(float) && alignof(Vector3) == alignof(float), "Vector3 must be three packed floats");
+static_assert(offsetof(Vector3, x) == 0 && offsetof(Vector3, y) == 4 && offsetof(Vector3, z) == 8, "Vector3 components must be x, y, z");
+
 #endif
\ No newline at end of file
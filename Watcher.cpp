@@ -0,0 +1,142 @@
+#include "Watcher.h"
+
+void WatchSet::Add(size_t id, uintptr_t addr, size_t size, Clock::duration interval) {
+    Entry entry{};
+    entry.id = id;
+    entry.addr = addr;
+    entry.size = size;
+    entry.interval = interval;
+    entry.due = Clock::now();
+    entries.push_back(entry);
+}
+
+bool WatchSet::Remove(size_t id) {
+    auto it = std::find_if(entries.begin(), entries.end(), [id](const Entry& entry) { return entry.id == id; });
+    if (it == entries.end()) return false;
+    entries.erase(it);
+    return true;
+}
+
+void WatchSet::Reprime(Clock::time_point now) {
+    for (Entry& entry : entries) {
+        entry.primed = false;
+        entry.due = now;
+    }
+}
+
+// The first successful sample of an entry only primes it; unreadable samples are skipped and keep the last value
+WatchSet::Clock::time_point WatchSet::Sample(const MemoryPhantom& phantom, Clock::time_point now, std::vector<WatchChange>& changed) {
+    changed.clear();
+    due.clear();
+    batch.Clear();
+    for (size_t i = 0; i < entries.size(); i++) {
+        Entry& entry = entries[i];
+        if (entry.due > now) continue;
+        due.push_back(i);
+        batch.AddBytes(entry.addr, entry.sample, entry.size);
+    }
+    if (!due.empty()) phantom.Execute(batch);
+
+    for (size_t slot = 0; slot < due.size(); slot++) {
+        Entry& entry = entries[due[slot]];
+        entry.due = std::max(entry.due + entry.interval, now);
+        if (!batch.Succeeded(slot)) continue;
+
+        if (entry.primed && memcmp(entry.last, entry.sample, entry.size) != 0) {
+            WatchChange& change = changed.emplace_back();
+            change.id = entry.id;
+            change.addr = entry.addr;
+            change.size = entry.size;
+            change.time = now;
+            memcpy(change.previous, entry.last, entry.size);
+            memcpy(change.current, entry.sample, entry.size);
+        }
+        memcpy(entry.last, entry.sample, entry.size);
+        entry.primed = true;
+    }
+
+    Clock::time_point next = Clock::time_point::max();
+    for (const Entry& entry : entries) next = std::min(next, entry.due);
+    return next;
+}
+
+Watcher::Watcher(const MemoryPhantom& phantom, size_t queueCapacity)
+    : phantom(phantom), changes(queueCapacity) {}
+
+Watcher::~Watcher() {
+    Stop();
+}
+
+size_t Watcher::AddBytes(uintptr_t addr, size_t size, Clock::duration interval) {
+    if (addr == 0 || size == 0 || size > WatchChange::MaxValueSize) return 0;
+
+    size_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = nextId++;
+        watches.Add(id, addr, size, interval);
+        scheduleChanged = true;
+    }
+    wake.notify_one();
+    return id;
+}
+
+bool Watcher::Remove(size_t id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return watches.Remove(id);
+}
+
+void Watcher::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    watches.Clear();
+}
+
+size_t Watcher::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return watches.Size();
+}
+
+Watcher::Clock::time_point Watcher::Tick() {
+    std::lock_guard<std::mutex> lock(mutex);
+    scheduleChanged = false;
+
+    Clock::time_point next = watches.Sample(phantom, Clock::now(), changed);
+    for (const WatchChange& change : changed) {
+        if (!changes.Push(change)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return next;
+}
+
+void Watcher::Start() {
+    if (running.exchange(true)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = false;
+    }
+    scheduler = std::thread([this] { Run(); });
+}
+
+void Watcher::Stop() {
+    if (!running.exchange(false)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    scheduler.join();
+}
+
+void Watcher::Run() {
+    while (true) {
+        Clock::time_point next = Tick();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (next == Clock::time_point::max()) {
+            wake.wait(lock, [this] { return stopping || scheduleChanged; });
+        }
+        else {
+            wake.wait_until(lock, next, [this] { return stopping || scheduleChanged; });
+        }
+        if (stopping) return;
+    }
+}
@@ -0,0 +1,165 @@
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include "MemoryPhantom.h"
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+template<typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : slots(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(slots.size() - 1) {}
+
+    bool Push(const T& value) {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) == slots.size()) return false;
+        slots[tail & mask] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& out) {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) return false;
+        out = slots[head & mask];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Capacity() const { return slots.size(); }
+
+private:
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> headIndex{ 0 };
+    alignas(64) std::atomic<size_t> tailIndex{ 0 };
+};
+
+struct WatchChange {
+    static constexpr size_t MaxValueSize = 64;
+
+    size_t id;
+    uintptr_t addr;
+    size_t size;
+    std::chrono::steady_clock::time_point time;
+    uint8_t previous[MaxValueSize];
+    uint8_t current[MaxValueSize];
+
+    template<typename T>
+    T Previous() const {
+        static_assert(sizeof(T) <= MaxValueSize, "Watched values are limited to MaxValueSize bytes");
+        T value;
+        memcpy(&value, previous, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    T Current() const {
+        static_assert(sizeof(T) <= MaxValueSize, "Watched values are limited to MaxValueSize bytes");
+        T value;
+        memcpy(&value, current, sizeof(T));
+        return value;
+    }
+};
+
+// Watch entries sampled with one ReadBatch per pass. Not synchronized; the owner holds its own lock.
+class WatchSet {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void Add(size_t id, uintptr_t addr, size_t size, Clock::duration interval);
+    bool Remove(size_t id);
+    void Clear() { entries.clear(); }
+    size_t Size() const { return entries.size(); }
+
+    // Makes every entry due at now and forgets its last value
+    void Reprime(Clock::time_point now);
+
+    // Samples every entry that is due, replaces changed with the values that differ from the last sample,
+    // and returns when the next entry is due
+    Clock::time_point Sample(const MemoryPhantom& phantom, Clock::time_point now, std::vector<WatchChange>& changed);
+
+private:
+    struct Entry {
+        size_t id;
+        uintptr_t addr;
+        size_t size;
+        Clock::duration interval;
+        Clock::time_point due;
+        bool primed;
+        uint8_t last[WatchChange::MaxValueSize];
+        uint8_t sample[WatchChange::MaxValueSize];
+    };
+
+    std::vector<Entry> entries;
+    std::vector<size_t> due;
+    ReadBatch batch;
+};
+
+class Watcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DefaultQueueCapacity = 4096;
+
+    explicit Watcher(const MemoryPhantom& phantom, size_t queueCapacity = DefaultQueueCapacity);
+    ~Watcher();
+
+    Watcher(const Watcher&) = delete;
+    Watcher& operator=(const Watcher&) = delete;
+
+    template<typename T>
+    size_t Add(uintptr_t addr, Clock::duration interval) {
+        static_assert(std::is_trivially_copyable_v<T>, "Watched values must be trivially copyable");
+        static_assert(!RemoteLayout<T>::defined, "Types with a RemoteLayout cannot be watched as a block");
+        static_assert(sizeof(T) <= WatchChange::MaxValueSize, "Watched values are limited to MaxValueSize bytes");
+        return AddBytes(addr, sizeof(T), interval);
+    }
+
+    template<typename T>
+    size_t Add(uintptr_t addr, int offset, Clock::duration interval) {
+        return Add<T>(addr + offset, interval);
+    }
+
+    size_t AddBytes(uintptr_t addr, size_t size, Clock::duration interval);
+    bool Remove(size_t id);
+    void Clear();
+    size_t Size() const;
+
+    // Samples every entry that is due and returns when the next one will be
+    Clock::time_point Tick();
+
+    void Start();
+    void Stop();
+    bool IsRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Consumer side; must be called from a single thread
+    bool Poll(WatchChange& out) { return changes.Pop(out); }
+    uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    void Run();
+
+    const MemoryPhantom& phantom;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    WatchSet watches;
+    std::vector<WatchChange> changed;
+    size_t nextId = 1;
+    bool scheduleChanged = false;
+
+    SpscQueue<WatchChange> changes;
+    std::atomic<uint64_t> dropped{ 0 };
+
+    std::thread scheduler;
+    std::atomic<bool> running{ false };
+    bool stopping = false;
+};
+
+#endif